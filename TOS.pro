@@ -1,48 +1,18 @@
-QT       += core gui
-
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
-
-CONFIG += c++11
-
-# You can make your code fail to compile if it uses deprecated APIs.
-# In order to do so, uncomment the following line.
-#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
-
-SOURCES += \
-    Character.cpp \
-    Enemy.cpp \
-    FinishStageWidget.cpp \
-    GameController.cpp \
-    GameStageWidget.cpp \
-    Gem.cpp \
-    PauseWidget.cpp \
-    PrepareStageWidget.cpp \
-    main.cpp \
-    MainWindow.cpp
-
-HEADERS += \
-    Character.h \
-    Enemy.h \
-    FinishStageWidget.h \
-    GameController.h \
-    GameStageWidget.h \
-    Gem.h \
-    PauseWidget.h \
-    PrepareStageWidget.h \
-    MainWindow.h
-
-FORMS += \
-    mainwindow.ui
-
-TRANSLATIONS += \
-    TOS_zh_TW.ts
-CONFIG += lrelease
-CONFIG += embed_translations
-
-# Default rules for deployment.
-qnx: target.path = /tmp/$${TARGET}/bin
-else: unix:!android: target.path = /opt/$${TARGET}/bin
-!isEmpty(target.path): INSTALLS += target
-
-RESOURCES += \
-    data.qrc
+TEMPLATE = subdirs
+
+# core      : 遊戲規則核心 (靜態函式庫，只依賴 QtCore)
+# app       : QtWidgets 介面，建立在 core 之上
+# simulator : 命令列 Monte Carlo mission 模擬器
+# bench     : 盤面與繪製熱點的 microbenchmark (QtTest)
+SUBDIRS += \
+    core \
+    app \
+    simulator \
+    bench
+
+simulator.subdir = tools/simulator
+bench.subdir = tools/bench
+
+app.depends = core
+simulator.depends = core
+bench.depends = core
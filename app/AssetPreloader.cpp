@@ -0,0 +1,158 @@
+// AssetPreloader.cpp
+#include "AssetPreloader.h"
+#include "Character.h"
+#include "GemSprite.h"
+#include "MissionTable.h"
+#include "SpriteCache.h"
+#include <QDebug>
+#include <QtConcurrent>
+
+AssetPreloader::AssetPreloader()
+    : started(false)
+{
+    connect(&watcher, &QFutureWatcher<Decoded>::resultReadyAt, this, &AssetPreloader::onResultReady);
+    connect(&watcher, &QFutureWatcher<Decoded>::finished, this, &AssetPreloader::onFinished);
+}
+
+AssetPreloader &AssetPreloader::instance()
+{
+    static AssetPreloader preloader;
+    return preloader;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// start(): 依畫面會用到的先後排序 (符石 → 角色 → 各 mission 的敵人) 後一次丟進 thread pool
+////////////////////////////////////////////////////////////////////////////////
+void AssetPreloader::start(qreal dpr)
+{
+    if (started) return;
+    started = true;
+
+    const QSize tile(Gem::TILE_SIZE, Gem::TILE_SIZE);
+    for (int effect : { Gem::Normal, Gem::Burning, Gem::Weathered }) {
+        for (int type : { Gem::Water, Gem::Fire, Gem::Earth, Gem::Light, Gem::Dark }) {
+            add(GemSprite::iconPathFor(Gem::Attribute(type), Gem::EffectStatus(effect)),
+                effect, dpr, { tile });
+        }
+    }
+
+    for (int id = 1; id <= Character::ROSTER_SIZE; ++id) {
+        add(Character::iconPathFor(id), 0, dpr,
+            { QSize(PREPARE_ICON_SIZE, PREPARE_ICON_SIZE), QSize(PARTY_ICON_SIZE, PARTY_ICON_SIZE) });
+    }
+
+    const MissionTable &table = MissionTable::shared();
+    for (int id = 1; id <= table.maxMissionID(); ++id) {
+        for (const QString &asset : missionAssets(id, QVector<int>())) {
+            add(asset, 0, dpr, { QSize(ENEMY_ICON_SIZE, ENEMY_ICON_SIZE) });
+        }
+    }
+
+    qDebug() << "[AssetPreloader] decoding" << requests.size() << "images";
+    watcher.setFuture(QtConcurrent::mapped(requests, &AssetPreloader::decode));
+}
+
+// 同一張圖只排一次 (missionAssets() 也會列出符石，已經排過就略過)
+void AssetPreloader::add(const QString &asset, int variant, qreal dpr, const QVector<QSize> &sizes)
+{
+    if (pending.contains(asset)) return;
+    pending.insert(asset);
+    requests.append({ asset, variant, dpr, sizes });
+}
+
+bool AssetPreloader::isRunning() const
+{
+    return !pending.isEmpty();
+}
+
+int AssetPreloader::readyCount() const
+{
+    return requests.size() - pending.size();
+}
+
+int AssetPreloader::totalCount() const
+{
+    return requests.size();
+}
+
+bool AssetPreloader::isReady(const QString &asset) const
+{
+    return !pending.contains(asset);
+}
+
+bool AssetPreloader::isReady(const QStringList &assets) const
+{
+    for (const QString &asset : assets) {
+        if (pending.contains(asset)) return false;
+    }
+    return true;
+}
+
+QStringList AssetPreloader::missionAssets(int missionID, const QVector<int> &characterIDs)
+{
+    QStringList assets;
+    for (int effect : { Gem::Normal, Gem::Burning, Gem::Weathered }) {
+        for (int type : { Gem::Water, Gem::Fire, Gem::Earth, Gem::Light, Gem::Dark }) {
+            assets.append(GemSprite::iconPathFor(Gem::Attribute(type), Gem::EffectStatus(effect)));
+        }
+    }
+    for (int id : characterIDs) {
+        if (id > 0) assets.append(Character::iconPathFor(id));
+    }
+
+    const MissionTable &table = MissionTable::shared();
+    if (const MissionTable::MissionDef *m = table.mission(missionID)) {
+        for (int w = 0; w < m->waveCount; ++w) {
+            const MissionTable::WaveDef &wave = table.wave(*m, w);
+            for (int slot = 0; slot < wave.enemyCount; ++slot) {
+                const QString &icon = table.iconPath(table.enemy(wave, slot));
+                if (!assets.contains(icon)) assets.append(icon);
+            }
+        }
+    }
+    return assets;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// decode(): worker thread；只用 QImage，不碰 QPixmap
+////////////////////////////////////////////////////////////////////////////////
+AssetPreloader::Decoded AssetPreloader::decode(const Request &request)
+{
+    Decoded out;
+    out.image = SpriteCache::decode(request.asset);
+    if (!out.image.isNull()) {
+        for (const QSize &size : request.sizes) {
+            out.scaled.append(SpriteCache::scale(out.image, size, request.dpr));
+        }
+    }
+    return out;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// onResultReady(): UI thread；交給 SpriteCache 後通知等待中的畫面
+//    解碼失敗的圖也算完成 (不擋住 Start)，之後用到時 SpriteCache 會再試一次並警告
+////////////////////////////////////////////////////////////////////////////////
+void AssetPreloader::onResultReady(int index)
+{
+    const Request &r = requests.at(index);
+    const Decoded d = watcher.resultAt(index);
+
+    if (!d.image.isNull()) {
+        SpriteCache &cache = SpriteCache::instance();
+        cache.adoptDecoded(r.asset, d.image);
+        for (int i = 0; i < d.scaled.size(); ++i) {
+            cache.adoptScaled(r.asset, r.sizes[i], r.dpr, r.variant, d.scaled[i]);
+        }
+    }
+
+    pending.remove(r.asset);
+    emit assetReady(r.asset);
+}
+
+void AssetPreloader::onFinished()
+{
+    // 取消或例外時可能有沒交回的結果；不讓 isReady() 永遠等下去
+    pending.clear();
+    qDebug() << "[AssetPreloader] done:" << SpriteCache::instance().stats().decodes << "images decoded";
+    emit finished();
+}
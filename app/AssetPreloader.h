@@ -0,0 +1,80 @@
+// AssetPreloader.h
+#pragma once
+
+#include <QFutureWatcher>
+#include <QImage>
+#include <QObject>
+#include <QSet>
+#include <QSize>
+#include <QStringList>
+#include <QVector>
+
+/*
+ * AssetPreloader
+ *  - 啟動時把 data.qrc 裡會用到的圖 (全部符石與效果變體、角色、所有 mission 的敵人)
+ *    交給 QtConcurrent 平行解碼，並在 worker 上先縮放成畫面實際使用的尺寸
+ *  - 每張圖完成時在 UI thread 交給 SpriteCache (QPixmap 只在這裡轉一次)，再發出 assetReady()
+ *  - UI 不必等全部完成：isReady() 只看呼叫端需要的那幾張；
+ *    還沒預載到的圖 SpriteCache 仍會在 UI thread 上同步解碼，結果一樣
+ *  - 只在 UI thread 使用
+ */
+class AssetPreloader : public QObject
+{
+    Q_OBJECT
+
+public:
+    // 畫面上使用的尺寸 (邏輯像素)
+    static constexpr int PREPARE_ICON_SIZE = 48;    // PrepareStageWidget 的角色下拉選單
+    static constexpr int PARTY_ICON_SIZE   = 80;    // GameStageWidget 的角色區
+    static constexpr int ENEMY_ICON_SIZE   = 100;   // GameStageWidget 的敵人區
+
+    static AssetPreloader &instance();
+
+    // 開始預載 (重複呼叫無妨)；dpr 為畫面的 device pixel ratio
+    void start(qreal dpr);
+
+    bool isRunning() const;
+    int  readyCount() const;
+    int  totalCount() const;
+
+    // 不在預載清單上的圖視為 ready
+    bool isReady(const QString &asset) const;
+    bool isReady(const QStringList &assets) const;
+
+    // 開始一場 mission 需要的圖：全部符石 + 選到的角色 + 這個 mission 所有波次的敵人
+    static QStringList missionAssets(int missionID, const QVector<int> &characterIDs);
+
+signals:
+    void assetReady(const QString &asset);
+    void finished();
+
+private slots:
+    void onResultReady(int index);
+    void onFinished();
+
+private:
+    AssetPreloader();
+    Q_DISABLE_COPY(AssetPreloader)
+
+    struct Request
+    {
+        QString        asset;
+        int            variant;     // SpriteCache 的效果變體
+        qreal          dpr;
+        QVector<QSize> sizes;       // 要預先縮放的尺寸
+    };
+
+    struct Decoded
+    {
+        QImage          image;
+        QVector<QImage> scaled;     // 與 Request::sizes 一一對應
+    };
+
+    static Decoded decode(const Request &request);
+    void add(const QString &asset, int variant, qreal dpr, const QVector<QSize> &sizes);
+
+    QVector<Request>        requests;
+    QSet<QString>           pending;    // 已排入、尚未交回的圖
+    QFutureWatcher<Decoded> watcher;
+    bool                    started;
+};
@@ -0,0 +1,543 @@
+// BoardWidget.cpp
+#include "BoardWidget.h"
+#include "FrameClock.h"
+#include "PerfStats.h"
+#include "StallWatchdog.h"
+#include "Trace.h"
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPaintEvent>
+#include <utility>
+
+BoardWidget::BoardWidget(QWidget *parent)
+    : QWidget(parent),
+      hiddenCells(0),
+      dirtyCells(0),
+      hintCells(0),
+      dirtyCountAtFlush(0),
+      animating(false),
+      cascadeRound(0),
+      cascadeStage(CascadeIdle),
+      cascadeStageStartMs(0),
+      inputEnabled(false),
+      dragging(false),
+      heldCell(-1),
+      hasPendingMove(false),
+      dragSwapCount(0),
+      preview()
+{
+    setFixedSize(GemBoard::COLS * Gem::TILE_SIZE, GemBoard::ROWS * Gem::TILE_SIZE);
+
+    // 每次 paintEvent 都會把髒區域完整蓋掉，不需要 Qt 先清背景
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setAttribute(Qt::WA_NoSystemBackground);
+
+    for (int r = 0; r < GemBoard::ROWS; ++r) {
+        for (int c = 0; c < GemBoard::COLS; ++c) {
+            sprites[r * GemBoard::COLS + c].setGem(Gem::empty(), r, c);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// tileRect(): 格子在 widget 裡的矩形
+////////////////////////////////////////////////////////////////////////////////
+QRect BoardWidget::tileRect(int r, int c)
+{
+    return QRect(c * Gem::TILE_SIZE, r * Gem::TILE_SIZE, Gem::TILE_SIZE, Gem::TILE_SIZE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// setBoard(): 同步盤面；只有外觀改變的格子與下落的欄需要重畫
+////////////////////////////////////////////////////////////////////////////////
+void BoardWidget::setBoard(const GemBoard &board)
+{
+    TOS_TRACE_SCOPE("BoardWidget::setBoard");
+    const qreal dpr = devicePixelRatioF();
+    const qint64 now = FrameClock::instance()->now();
+    BitBoard::Mask dirty = 0;
+    BitBoard::Mask fallen = 0;
+
+    // 先前被消除的格子：該欄由第 0 列到最下面的消除格整段落下
+    //  - 最上方 holes 格是新補的符石，從盤面外掉 holes 格
+    //  - 其餘是原本沒被消除的符石，依序往下壓實
+    if (hiddenCells) {
+        for (int c = 0; c < GemBoard::COLS; ++c) {
+            BitBoard::Mask colHidden = hiddenCells & BitBoard::columnMask(c);
+            if (!colHidden) continue;
+            const int lowestRow = BitBoard::rowOf(BitBoard::highestIndex(colHidden));
+            const int holes = BitBoard::count(colHidden);
+
+            int keptIndex = 0;
+            for (int origin = 0; origin <= lowestRow; ++origin) {
+                if (colHidden & BitBoard::bit(origin, c)) continue;
+                const int r = holes + keptIndex++;
+                GemSprite &sprite = sprites[r * GemBoard::COLS + c];
+                sprite.setGem(board.at(r, c), origin, c, dpr);
+                sprite.startFalling(r - origin, now);
+            }
+            for (int r = 0; r < holes; ++r) {
+                GemSprite &sprite = sprites[r * GemBoard::COLS + c];
+                sprite.setGem(board.at(r, c), r - holes, c, dpr);
+                sprite.startFalling(holes, now);
+            }
+            for (int r = 0; r <= lowestRow; ++r) {
+                fallen |= BitBoard::bit(r, c);
+            }
+        }
+        hiddenCells = 0;
+    }
+
+    for (int i = 0; i < GemBoard::CELLS; ++i) {
+        if (fallen & (BitBoard::Mask(1) << i)) continue;
+        GemSprite &sprite = sprites[i];
+        const Gem &g = board.cell(i);
+        if (!g.looksLike(sprite.getGem())) {
+            sprite.setGem(g, BitBoard::rowOf(i), BitBoard::colOf(i), dpr);
+            dirty |= BitBoard::Mask(1) << i;
+        }
+    }
+
+    markDirty(dirty | fallen);
+    flushDirty();
+    if (fallen) startAnimating();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// clearBoard(): 全部清成空格
+////////////////////////////////////////////////////////////////////////////////
+void BoardWidget::clearBoard()
+{
+    for (int i = 0; i < GemBoard::CELLS; ++i) {
+        sprites[i].setGem(Gem::empty(), BitBoard::rowOf(i), BitBoard::colOf(i));
+    }
+    hiddenCells = 0;
+    hintCells = 0;
+    hintPath.clear();
+    preview = MatchTracker::Preview();
+    cascadeStage = CascadeIdle;
+    dragging = false;
+    hasPendingMove = false;
+    heldCell = -1;
+    if (animating) {
+        animating = false;
+        FrameClock::instance()->release(this);
+    }
+    markDirty(BitBoard::FULL);
+    flushDirty();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// swapTiles(): 交換兩格，只重畫這兩格
+////////////////////////////////////////////////////////////////////////////////
+void BoardWidget::swapTiles(int r1, int c1, int r2, int c2)
+{
+    GemSprite &a = sprites[r1 * GemBoard::COLS + c1];
+    GemSprite &b = sprites[r2 * GemBoard::COLS + c2];
+
+    // 兩個 sprite 互換目標位置後，再互換在陣列中的格子，讓 index 仍對應 (row,col)
+    a.swapWith(&b, FrameClock::instance()->now());
+    std::swap(a, b);
+
+    markDirty(BitBoard::bit(r1, c1) | BitBoard::bit(r2, c2));
+    flushDirty();
+    startAnimating();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// hideCells(): 消除動畫，只重畫被消除的格子
+////////////////////////////////////////////////////////////////////////////////
+void BoardWidget::hideCells(BitBoard::Mask cells)
+{
+    cells &= BitBoard::FULL;
+    hiddenCells |= cells;
+    markDirty(cells);
+    flushDirty();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// playCascade(): 逐輪播放 cascade；每輪 = 藏起 cleared → 停頓 → setBoard(boardAfter) 下落
+////////////////////////////////////////////////////////////////////////////////
+void BoardWidget::playCascade(const GameEngine::Cascade &c)
+{
+    if (c.roundCount <= 0) {
+        emit cascadeFinished();
+        return;
+    }
+    TOS_TRACE_ASYNC_BEGIN("cascadeAnimation", 1);
+    cascade = c;
+    cascadeRound = 0;
+    beginCascadeRound(FrameClock::instance()->now());
+    startAnimating();
+}
+
+bool BoardWidget::isPlayingCascade() const
+{
+    return cascadeStage != CascadeIdle;
+}
+
+void BoardWidget::beginCascadeRound(qint64 nowMs)
+{
+    hideCells(cascade.rounds[cascadeRound].cleared);
+    cascadeStage = CascadeClearing;
+    cascadeStageStartMs = nowMs;
+}
+
+// 回傳 cascade 是否還在播放
+bool BoardWidget::advanceCascade(qint64 nowMs, bool spritesMoving)
+{
+    switch (cascadeStage) {
+        case CascadeIdle:
+            return false;
+
+        case CascadeClearing:
+            if (nowMs - cascadeStageStartMs >= CASCADE_CLEAR_MS) {
+                setBoard(cascade.rounds[cascadeRound].boardAfter);
+                cascadeStage = CascadeFalling;
+                cascadeStageStartMs = nowMs;
+            }
+            return true;
+
+        case CascadeFalling:
+            if (spritesMoving) return true;
+            if (++cascadeRound < cascade.roundCount) {
+                beginCascadeRound(nowMs);
+                return true;
+            }
+            cascadeStage = CascadeIdle;
+            return false;
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// cellAt(): 座標直接換算成格子，不需要逐格做 hit-test
+////////////////////////////////////////////////////////////////////////////////
+int BoardWidget::cellAt(const QPoint &pos)
+{
+    if (pos.x() < 0 || pos.y() < 0) return -1;
+    const int c = pos.x() / Gem::TILE_SIZE;
+    const int r = pos.y() / Gem::TILE_SIZE;
+    if (r >= GemBoard::ROWS || c >= GemBoard::COLS) return -1;
+    return r * GemBoard::COLS + c;
+}
+
+void BoardWidget::setInputEnabled(bool enabled)
+{
+    inputEnabled = enabled;
+    if (!enabled && dragging) {
+        applyDrag();
+        endDrag(false);
+    }
+}
+
+bool BoardWidget::isInputEnabled() const
+{
+    return inputEnabled;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 轉珠：press 拿起、move 只記位置、每幀 applyDrag()、release 放下
+////////////////////////////////////////////////////////////////////////////////
+void BoardWidget::mousePressEvent(QMouseEvent *event)
+{
+    const int cell = cellAt(event->pos());
+    if (!inputEnabled || dragging || isPlayingCascade() ||
+        event->button() != Qt::LeftButton || cell < 0)
+    {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+
+    dragging = true;
+    heldCell = cell;
+    dragPos = pendingPos = event->pos();
+    hasPendingMove = false;
+    dragSwapCount = 0;
+
+    setHint(0);
+    update(tileRect(BitBoard::rowOf(cell), BitBoard::colOf(cell)) | heldRect());
+    startAnimating();
+}
+
+void BoardWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    if (!dragging) {
+        QWidget::mouseMoveEvent(event);
+        return;
+    }
+    // 同一幀內的多個 move 事件只留最後一個
+    pendingPos = event->pos();
+    hasPendingMove = true;
+}
+
+void BoardWidget::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (!dragging || event->button() != Qt::LeftButton) {
+        QWidget::mouseReleaseEvent(event);
+        return;
+    }
+    pendingPos = event->pos();
+    hasPendingMove = true;
+    applyDrag();
+    endDrag(true);
+}
+
+// 手上符石畫在游標正中央
+QRect BoardWidget::heldRect() const
+{
+    return QRect(dragPos.x() - Gem::TILE_SIZE / 2, dragPos.y() - Gem::TILE_SIZE / 2,
+                 Gem::TILE_SIZE, Gem::TILE_SIZE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// applyDrag(): 套用最新的游標位置；每次只往目標移動一格 (較遠的軸優先)，
+//    所以快速甩動也會沿途逐格交換，每一步都是 O(1)
+////////////////////////////////////////////////////////////////////////////////
+void BoardWidget::applyDrag()
+{
+    if (!dragging || !hasPendingMove) return;
+    hasPendingMove = false;
+
+    const QRect oldHeld = heldRect();
+    dragPos = QPoint(qBound(0, pendingPos.x(), width() - 1),
+                     qBound(0, pendingPos.y(), height() - 1));
+
+    const int target = cellAt(dragPos);
+    const qint64 now = FrameClock::instance()->now();
+    BitBoard::Mask swapped = 0;
+
+    while (target >= 0 && heldCell != target) {
+        const int r = BitBoard::rowOf(heldCell);
+        const int c = BitBoard::colOf(heldCell);
+        const int dr = BitBoard::rowOf(target) - r;
+        const int dc = BitBoard::colOf(target) - c;
+
+        int nr = r;
+        int nc = c;
+        if (qAbs(dr) >= qAbs(dc)) nr += (dr > 0) ? 1 : -1;
+        else                      nc += (dc > 0) ? 1 : -1;
+        const int next = nr * GemBoard::COLS + nc;
+
+        // 被擠開的符石以交換動畫移到原本手上符石的格子
+        GemSprite &held = sprites[heldCell];
+        GemSprite &other = sprites[next];
+        held.swapWith(&other, now);
+        std::swap(held, other);
+
+        swapped |= BitBoard::bit(r, c) | BitBoard::bit(nr, nc);
+        ++dragSwapCount;
+        emit gemDragged(r, c, nr, nc);
+        heldCell = next;
+    }
+
+    markDirty(swapped);
+    flushDirty();
+    update(oldHeld | heldRect());
+}
+
+void BoardWidget::endDrag(bool notify)
+{
+    const QRect oldHeld = heldRect();
+    const int cell = heldCell;
+    dragging = false;
+    hasPendingMove = false;
+    heldCell = -1;
+
+    if (cell >= 0) {
+        update(oldHeld | tileRect(BitBoard::rowOf(cell), BitBoard::colOf(cell)));
+    }
+    if (notify) emit dragFinished(dragSwapCount);
+    dragSwapCount = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// setPreview(): 只重畫 matched 有變動的格子與左上角的數字
+////////////////////////////////////////////////////////////////////////////////
+void BoardWidget::setPreview(const MatchTracker::Preview &p)
+{
+    const BitBoard::Mask cells = p.matched & BitBoard::FULL;
+    const bool textChanged = p.comboCount != preview.comboCount || p.damage != preview.damage;
+    if (cells == preview.matched && !textChanged) return;
+
+    markDirty(cells ^ preview.matched);
+    preview = p;
+    preview.matched = cells;
+    flushDirty();
+    if (textChanged) update(previewBadgeRect());
+}
+
+QRect BoardWidget::previewBadgeRect()
+{
+    return QRect(6, 6, 3 * Gem::TILE_SIZE, 28);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// setHint(): 只重畫新舊提示格與新舊路徑經過的格子
+//    路徑只連相鄰格，線段不會超出這些格子
+////////////////////////////////////////////////////////////////////////////////
+void BoardWidget::setHint(BitBoard::Mask cells, const QVector<int> &path)
+{
+    cells &= BitBoard::FULL;
+    if (cells == hintCells && path == hintPath) return;
+
+    BitBoard::Mask dirty = cells | hintCells;
+    for (int i : hintPath) dirty |= BitBoard::Mask(1) << i;
+    for (int i : path) dirty |= BitBoard::Mask(1) << i;
+    markDirty(dirty);
+    hintCells = cells;
+    hintPath = path;
+    flushDirty();
+}
+
+int BoardWidget::lastDirtyCount() const
+{
+    return dirtyCountAtFlush;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// markDirty() / flushDirty(): 累積髒格子，合併成 QRegion 後一次 update()
+////////////////////////////////////////////////////////////////////////////////
+void BoardWidget::markDirty(BitBoard::Mask cells)
+{
+    dirtyCells |= cells;
+}
+
+void BoardWidget::flushDirty()
+{
+    if (!dirtyCells) return;
+
+    dirtyCountAtFlush = BitBoard::count(dirtyCells);
+
+    // 每一列連續的髒格子合併成一個矩形
+    QRegion region;
+    for (int r = 0; r < GemBoard::ROWS; ++r) {
+        int c = 0;
+        while (c < GemBoard::COLS) {
+            if (!(dirtyCells & BitBoard::bit(r, c))) { ++c; continue; }
+            int start = c;
+            while (c < GemBoard::COLS && (dirtyCells & BitBoard::bit(r, c))) ++c;
+            region += QRect(start * Gem::TILE_SIZE, r * Gem::TILE_SIZE,
+                            (c - start) * Gem::TILE_SIZE, Gem::TILE_SIZE);
+        }
+    }
+
+    dirtyCells = 0;
+    update(region);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// startAnimating() / onFrame(): 有 sprite 在動才向 FrameClock 要幀
+////////////////////////////////////////////////////////////////////////////////
+void BoardWidget::startAnimating()
+{
+    if (animating) return;
+    animating = true;
+    connect(FrameClock::instance(), &FrameClock::frame,
+            this, &BoardWidget::onFrame, Qt::UniqueConnection);
+    FrameClock::instance()->requestFrames(this);
+}
+
+void BoardWidget::onFrame(qint64 nowMs)
+{
+    StallWatchdog::Mark mark("BoardWidget::onFrame");
+    TOS_TRACE_SCOPE("BoardWidget::onFrame");
+    if (!animating) return;
+
+    // 上一幀之後累積的游標移動，在這一幀一次套用
+    applyDrag();
+
+    // 只重畫移動中 sprite 的舊位置與新位置
+    QRegion region;
+    bool stillMoving = false;
+    for (GemSprite &sprite : sprites) {
+        if (!sprite.isAnimating()) continue;
+        region += sprite.getRect();
+        stillMoving |= sprite.advance(nowMs);
+        region += sprite.getRect();
+    }
+    if (!region.isEmpty()) update(region);
+
+    const bool wasPlaying = isPlayingCascade();
+    const bool playing = advanceCascade(nowMs, stillMoving);
+
+    if (!stillMoving && !playing && !dragging) {
+        animating = false;
+        FrameClock::instance()->release(this);
+    }
+    if (wasPlaying && !playing) {
+        TOS_TRACE_ASYNC_END("cascadeAnimation", 1);
+        emit cascadeFinished();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// paintEvent(): 只畫與髒區域相交的 sprite
+////////////////////////////////////////////////////////////////////////////////
+void BoardWidget::paintEvent(QPaintEvent *event)
+{
+    TOS_TRACE_SCOPE("BoardWidget::paintEvent");
+    PerfStats::Scope scope(PerfStats::PaintTime);
+    QPainter painter(this);
+    const QRect area = event->rect();
+
+    painter.fillRect(area, Qt::black);
+
+    for (int i = 0; i < GemBoard::CELLS; ++i) {
+        if (hiddenCells & (BitBoard::Mask(1) << i)) continue;
+        if (dragging && i == heldCell) continue;
+        const GemSprite &sprite = sprites[i];
+        if (!area.intersects(sprite.getRect())) continue;
+        sprite.paint(&painter);
+    }
+
+    if (hintCells) {
+        painter.setPen(QPen(QColor(255, 220, 0), 4));
+        painter.setBrush(Qt::NoBrush);
+        BitBoard::Mask cells = hintCells;
+        while (cells) {
+            const int i = BitBoard::lowestIndex(cells);
+            cells &= cells - 1;
+            const QRect rect = tileRect(BitBoard::rowOf(i), BitBoard::colOf(i)).adjusted(2, 2, -2, -2);
+            if (area.intersects(rect)) painter.drawRect(rect);
+        }
+    }
+
+    if (hintPath.size() > 1) {
+        QPolygon line;
+        for (int i : hintPath) {
+            line << tileRect(BitBoard::rowOf(i), BitBoard::colOf(i)).center();
+        }
+        painter.setPen(QPen(QColor(255, 220, 0, 180), 6, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawPolyline(line);
+        painter.setBrush(QColor(255, 220, 0, 180));
+        painter.drawEllipse(line.last(), 8, 8);
+    }
+
+    if (preview.matched) {
+        BitBoard::Mask cells = preview.matched;
+        while (cells) {
+            const int i = BitBoard::lowestIndex(cells);
+            cells &= cells - 1;
+            const QRect rect = tileRect(BitBoard::rowOf(i), BitBoard::colOf(i));
+            if (area.intersects(rect)) painter.fillRect(rect, QColor(255, 255, 255, 70));
+        }
+
+        const QRect badge = previewBadgeRect();
+        if (area.intersects(badge)) {
+            painter.fillRect(badge, QColor(0, 0, 0, 160));
+            painter.setPen(Qt::white);
+            painter.drawText(badge.adjusted(8, 0, -8, 0), Qt::AlignVCenter | Qt::AlignLeft,
+                             QString("%1 Combo   %2 DMG").arg(preview.comboCount).arg(preview.damage));
+        }
+    }
+
+    // 手上的符石最後畫，蓋在盤面之上
+    if (dragging && heldCell >= 0) {
+        const QRect rect = heldRect();
+        if (area.intersects(rect)) {
+            painter.drawPixmap(rect, sprites[heldCell].getPixmap());
+        }
+    }
+}
@@ -0,0 +1,123 @@
+// BoardWidget.h
+#pragma once
+
+#include <QWidget>
+#include <QRegion>
+#include "GameEngine.h"
+#include "MatchTracker.h"
+#include "GemSprite.h"
+
+/*
+ * BoardWidget
+ *  - 取代 30 個 QLabel 的符石盤面，由 GemSprite::paint() 自己畫
+ *  - 以 BitBoard::Mask 記錄髒格子，一次 flush 成 QRegion 再 update()
+ *    · 交換：只重畫兩格
+ *    · 消除：只重畫被消除的格子
+ *    · 下落：只重畫受影響的欄 (由第 0 列畫到最下面的消除格)
+ *  - 交換與下落以 FrameClock 驅動；動畫期間每幀只重畫移動中 sprite 的新舊位置，
+ *    全部停下後立刻 release 時鐘
+ *  - playCascade() 依 GameEngine::Cascade 的步驟列表逐輪播放：消除 → 停頓 → 下落，
+ *    全部播完才發出 cascadeFinished()
+ *  - 轉珠：按下拿起一顆符石，之後每跨過一條格線就和相鄰格交換一次 (gemDragged)
+ *    · 格子由座標除以 TILE_SIZE 直接算出，不靠每格 widget 的事件
+ *    · mouseMove 只記下最新位置，下一幀才套用；快速甩動時沿途逐格交換，不會跳格
+ */
+class BoardWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit BoardWidget(QWidget *parent = nullptr);
+
+    // 同步盤面；只有內容改變的格子會重畫
+    void setBoard(const GemBoard &board);
+
+    // 全部清成黑底空格
+    void clearBoard();
+
+    // 交換兩格 (拖曳或 swap 時使用)
+    void swapTiles(int r1, int c1, int r2, int c2);
+
+    // 消除動畫：先把格子藏起來，等下一次 setBoard() 再依欄位落下
+    void hideCells(BitBoard::Mask cells);
+
+    // 是否接受轉珠輸入 (關閉時若正在拖曳會直接放下，不發出 dragFinished)
+    void setInputEnabled(bool enabled);
+    bool isInputEnabled() const;
+
+    // widget 座標 → 格子 index (超出盤面回傳 -1)
+    static int cellAt(const QPoint &pos);
+
+    // 轉珠預覽：淡色標出會消除的格子，左上角顯示 combo 與傷害 (matched = 0 不顯示)
+    void setPreview(const MatchTracker::Preview &preview);
+
+    // 提示框：在指定格子外圍畫框 (0 = 不顯示)；path 為依序經過的格子，連成一條拖動路徑
+    void setHint(BitBoard::Mask cells, const QVector<int> &path = QVector<int>());
+
+    // 播放 engine 解好的整串 cascade
+    void playCascade(const GameEngine::Cascade &cascade);
+    bool isPlayingCascade() const;
+
+    // 上一次 flush 重畫了幾格 (給效能量測用)
+    int lastDirtyCount() const;
+
+    // 格子在 widget 裡的矩形
+    static QRect tileRect(int r, int c);
+
+signals:
+    void cascadeFinished();
+
+    // 拖曳中跨過格線：(r1,c1) 為手上符石原本的格子
+    void gemDragged(int r1, int c1, int r2, int c2);
+
+    // 放開：本次拖曳一共交換了幾次
+    void dragFinished(int swapCount);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+
+private slots:
+    void onFrame(qint64 nowMs);
+
+private:
+    void markDirty(BitBoard::Mask cells);
+    void flushDirty();
+    void startAnimating();
+    void beginCascadeRound(qint64 nowMs);
+    bool advanceCascade(qint64 nowMs, bool spritesMoving);
+    void applyDrag();
+    void endDrag(bool notify);
+    QRect heldRect() const;
+    static QRect previewBadgeRect();
+
+    // 每輪消除後停頓多久才開始下落
+    static constexpr int CASCADE_CLEAR_MS = 200;
+
+    enum CascadeStage { CascadeIdle = 0, CascadeClearing, CascadeFalling };
+
+    GemSprite       sprites[GemBoard::CELLS];   // 每格一個，重複使用
+    BitBoard::Mask  hiddenCells;                // 消除中、暫時不畫的格子
+    BitBoard::Mask  dirtyCells;                 // 尚未送出 update() 的格子
+    BitBoard::Mask  hintCells;                  // 目前顯示提示框的格子
+    QVector<int>    hintPath;                   // 目前顯示的拖動路徑 (格子 index)
+    int             dirtyCountAtFlush;
+    bool            animating;                  // 目前是否向 FrameClock 要幀
+
+    GameEngine::Cascade cascade;                // 播放中的步驟列表 (複製一份)
+    int             cascadeRound;               // 目前播到第幾輪
+    CascadeStage    cascadeStage;
+    qint64          cascadeStageStartMs;
+
+    bool            inputEnabled;
+    bool            dragging;
+    int             heldCell;                   // 手上符石目前所在的格子
+    QPoint          dragPos;                    // 已套用的游標位置
+    QPoint          pendingPos;                 // 最新的游標位置 (下一幀套用)
+    bool            hasPendingMove;
+    int             dragSwapCount;
+
+    MatchTracker::Preview preview;              // 轉珠中的即時預覽
+};
@@ -0,0 +1,81 @@
+// FrameClock.cpp
+#include "FrameClock.h"
+#include "PerfStats.h"
+#include <QCoreApplication>
+
+FrameClock::FrameClock(QObject *parent)
+    : QObject(parent),
+      timer(new QTimer(this)),
+      lastFrameNs(-1)
+{
+    elapsed.start();
+
+    timer->setTimerType(Qt::PreciseTimer);
+    timer->setInterval(DEFAULT_INTERVAL_MS);
+    connect(timer, &QTimer::timeout, this, &FrameClock::onTimeout);
+
+    clients.reserve(8);
+}
+
+FrameClock *FrameClock::instance()
+{
+    // 掛在 QCoreApplication 底下，程式結束時與其他 QObject 一起釋放
+    static FrameClock *clock = new FrameClock(QCoreApplication::instance());
+    return clock;
+}
+
+qint64 FrameClock::now() const
+{
+    return elapsed.elapsed();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// requestFrames() / release(): 有 client 才跑，沒有就停
+////////////////////////////////////////////////////////////////////////////////
+void FrameClock::requestFrames(QObject *client)
+{
+    if (!client || clients.contains(client)) return;
+
+    clients.append(client);
+    connect(client, &QObject::destroyed, this, [this](QObject *obj) {
+        release(obj);
+    });
+
+    if (!timer->isActive()) {
+        lastFrameNs = -1;
+        timer->start();
+    }
+}
+
+void FrameClock::release(QObject *client)
+{
+    if (!clients.removeOne(client)) return;
+
+    disconnect(client, &QObject::destroyed, this, nullptr);
+    if (clients.isEmpty()) {
+        timer->stop();
+    }
+}
+
+bool FrameClock::isRunning() const
+{
+    return timer->isActive();
+}
+
+void FrameClock::setFrameInterval(int ms)
+{
+    timer->setInterval(qMax(1, ms));
+}
+
+void FrameClock::onTimeout()
+{
+    // 幀間隔只算連續執行中的幀；時鐘停過再啟動的第一幀不算
+    const qint64 nowNs = elapsed.nsecsElapsed();
+    if (lastFrameNs >= 0) {
+        PerfStats &stats = PerfStats::instance();
+        if (stats.isEnabled()) stats.record(PerfStats::FrameTime, nowNs - lastFrameNs);
+    }
+    lastFrameNs = nowNs;
+
+    emit frame(nowNs / 1000000);
+}
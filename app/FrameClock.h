@@ -0,0 +1,52 @@
+// FrameClock.h
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QVector>
+
+/*
+ * FrameClock
+ *  - 全域唯一的畫面時鐘，以 QElapsedTimer 提供單調遞增的毫秒時間
+ *  - 只有在有 client 呼叫 requestFrames() 時才啟動計時器，每幀發出 frame(nowMs)
+ *  - 所有 client 都 release() 之後計時器立刻停止，盤面靜止時完全不耗 CPU
+ *  - 動畫一律以 nowMs 做時間內插，所以實際幀率 (30/60/144 Hz) 不影響移動速度
+ */
+class FrameClock : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int DEFAULT_INTERVAL_MS = 16;
+
+    static FrameClock *instance();
+
+    // 自時鐘建立以來經過的毫秒數
+    qint64 now() const;
+
+    // client 需要每幀更新 (重複呼叫無妨)
+    void requestFrames(QObject *client);
+
+    // client 不再需要更新；沒有 client 時時鐘停止
+    void release(QObject *client);
+
+    bool isRunning() const;
+
+    // 調整幀間隔 (毫秒)
+    void setFrameInterval(int ms);
+
+signals:
+    void frame(qint64 nowMs);
+
+private slots:
+    void onTimeout();
+
+private:
+    explicit FrameClock(QObject *parent = nullptr);
+
+    QElapsedTimer     elapsed;
+    QTimer           *timer;
+    qint64            lastFrameNs;  // 上一幀的時間 (給效能 HUD 的幀間隔；-1 = 剛啟動)
+    QVector<QObject*> clients;
+};
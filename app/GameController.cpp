@@ -0,0 +1,355 @@
+// GameController.cpp
+#include "GameController.h"
+#include "PerfStats.h"
+#include "ReplayFile.h"
+#include "StallWatchdog.h"
+#include "Trace.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QRandomGenerator>
+#include <QStandardPaths>
+
+GameController::GameController(QObject *parent)
+    : QObject(parent),
+      moveTimer(new QTimer(this)),
+      pendingDamage(0),
+      hintEngine(new HintEngine(this)),
+      events(new GameEventChannel(this)),
+      partyHP(0),
+      presetSeed(0),
+      hasPresetSeed(false)
+{
+    moveTimer->setSingleShot(true);
+    moveTimer->setInterval(10 * 1000);
+    connect(moveTimer, &QTimer::timeout, this, &GameController::onMoveTimeout);
+    connect(hintEngine, &HintEngine::hintReady, this, &GameController::hintReady);
+}
+
+GameController::~GameController()
+{
+    // Enemy* 由 GameEngine 釋放
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// init(): 傳入玩家 Character* 陣列、missionID
+////////////////////////////////////////////////////////////////////////////////
+void GameController::init(const QVector<Character*> &playerChars, int missionID)
+{
+    moveTimer->stop();
+    hintEngine->cancel();
+    events->clear();
+    engine.init(playerChars, missionID);
+}
+
+void GameController::setPartySetup(const QVector<int> &team, int totalHP)
+{
+    partyTeam = team;
+    partyHP = totalHP;
+}
+
+void GameController::setMissionSeed(quint32 seed)
+{
+    presetSeed = seed;
+    hasPresetSeed = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// startMission(): 根據 missionID 先產生三波 enemies，再產生 board，然後倒數 10 秒
+//    每局一個 mission 種子；同一個種子 + InputLog 的輸入就能完整重現這一局
+////////////////////////////////////////////////////////////////////////////////
+void GameController::startMission()
+{
+    const quint32 seed = hasPresetSeed ? presetSeed : QRandomGenerator::global()->generate();
+    hasPresetSeed = false;
+
+    engine.setSeed(seed);
+    inputLog.begin(seed, engine.missionId(), partyTeam, partyHP);
+    missionClock.start();
+
+    engine.startMission();
+    emit moveTimeUp();
+    if (engine.phase() == GameEngine::PlayerMove) {
+        beginPlayerTurn();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// beginPlayerTurn(): 開始倒數、背景算提示、以新盤面重建轉珠預覽
+////////////////////////////////////////////////////////////////////////////////
+void GameController::beginPlayerTurn()
+{
+    TOS_TRACE_SCOPE("GameController::beginPlayerTurn");
+    moveTimer->start();
+    requestHint();
+    dragMatches.reset(engine.board());
+    events->post(GameEvent::PlayerTurnStarted);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 取得「目前波次」的 Enemy* 清單
+////////////////////////////////////////////////////////////////////////////////
+QVector<Enemy*> GameController::getCurrentWaveEnemies() const
+{
+    return engine.currentWaveEnemies();
+}
+
+QVector<Enemy*> GameController::getNextWaveEnemies() const
+{
+    return engine.waveEnemies(engine.currentWave() + 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 取得目前的盤面
+////////////////////////////////////////////////////////////////////////////////
+const GemBoard &GameController::getBoardMatrix() const
+{
+    return engine.board();
+}
+
+const GameEngine &GameController::getEngine() const
+{
+    return engine;
+}
+
+const InputLog &GameController::getInputLog() const
+{
+    return inputLog;
+}
+
+GameEventChannel *GameController::eventChannel() const
+{
+    return events;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// swapGems(): 轉珠途中每跨一格呼叫一次 → 交換盤面、寫進輸入紀錄
+//    倒數與提示等放開時 (onPlayerSwapFinished) 才處理
+////////////////////////////////////////////////////////////////////////////////
+bool GameController::swapGems(int r1, int c1, int r2, int c2)
+{
+    if (!engine.swapGems(r1, c1, r2, c2)) return false;
+    inputLog.addSwap(missionTick(), r1, c1, r2, c2);
+
+    // 只重算經過這兩格的列與欄
+    dragMatches.swap(r1, c1, r2, c2);
+    const MatchTracker::Preview preview = dragMatches.preview();
+    GameEvent e = GameEvent::make(GameEvent::PreviewChanged);
+    e.cells = preview.matched;
+    e.comboCount = quint16(preview.comboCount);
+    for (int a = 0; a < BitBoard::ATTR_COUNT; ++a) {
+        e.clearedCount[a] = quint16(preview.clearedCount[a]);
+    }
+    e.damage = engine.estimateDamage(preview.clearedCount, preview.comboCount).total;
+    events->post(e);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// onPlayerSwapFinished(): 玩家完成一次 swap → 重置倒數，提示以新盤面重算
+////////////////////////////////////////////////////////////////////////////////
+void GameController::onPlayerSwapFinished()
+{
+    if (engine.phase() != GameEngine::PlayerMove) return;
+    moveTimer->stop();
+    moveTimer->start();
+    requestHint();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// requestHint(): 以目前盤面、隊伍與本波目標在背景算提示
+////////////////////////////////////////////////////////////////////////////////
+void GameController::requestHint()
+{
+    hintEngine->request(engine.board(), engine.partyCombatants(), engine.currentDefender());
+}
+
+void GameController::setDragAssist(bool enabled)
+{
+    if (hintEngine->isDragAssist() == enabled) return;
+    hintEngine->setDragAssist(enabled);
+    if (engine.phase() == GameEngine::PlayerMove) {
+        requestHint();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// startMoveTimer(): UI 可以呼叫此 slot 來「手動」啟動 10 秒
+////////////////////////////////////////////////////////////////////////////////
+void GameController::startMoveTimer()
+{
+    if (engine.phase() == GameEngine::PlayerMove && moveTimer) {
+        moveTimer->start();
+        qDebug() << "[GameController] moveTimer started";
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// onMoveTimeout(): 倒數 10 秒結束 → 消除判定
+////////////////////////////////////////////////////////////////////////////////
+void GameController::onMoveTimeout()
+{
+    StallWatchdog::Mark mark("GameController::onMoveTimeout");
+    TOS_TRACE_SCOPE("GameController::onMoveTimeout");
+    if (engine.phase() != GameEngine::PlayerMove) return;
+
+    // 放開手指 → 下一次輪到玩家：整段消除、掉落、敵人回合
+    TOS_TRACE_ASYNC_BEGIN("turn", 1);
+    hintEngine->cancel();
+    emit moveTimeUp();
+    inputLog.addEndMove(missionTick());
+    engine.endMove();
+    advanceEngine();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// onCascadePlayed(): UI 播完 cascade 後呼叫 → 送出這回合的總傷害
+////////////////////////////////////////////////////////////////////////////////
+void GameController::onCascadePlayed()
+{
+    TOS_TRACE_SCOPE("GameController::onCascadePlayed");
+    GameEvent e = GameEvent::make(GameEvent::DamageDealt);
+    e.damage = pendingDamage;
+    events->post(e);
+    pendingDamage = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// onEnemiesAttacked(): UI 播放完受傷動畫後呼叫 → 敵人回合或下一波
+////////////////////////////////////////////////////////////////////////////////
+void GameController::onEnemiesAttacked()
+{
+    TOS_TRACE_SCOPE("GameController::onEnemiesAttacked");
+    advanceEngine();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// advanceEngine(): 推進 engine；效能 HUD 開著時記下整段與 engine 各階段的耗時
+////////////////////////////////////////////////////////////////////////////////
+void GameController::advanceEngine()
+{
+    StallWatchdog::Mark mark("GameController::advanceEngine");
+    TOS_TRACE_SCOPE("GameController::advanceEngine");
+    PerfStats::Scope scope(PerfStats::Controller);
+    engine.setProfiling(PerfStats::instance().isEnabled());
+    runEngine();
+    recordPhaseTimes();
+}
+
+void GameController::recordPhaseTimes()
+{
+    // 每次都取出歸零，HUD 關著時累計的不會混進下一次開啟
+    const GameEngine::PhaseTimes t = engine.takePhaseTimes();
+    PerfStats &stats = PerfStats::instance();
+    if (!stats.isEnabled()) return;
+
+    // 沒有執行到的階段是 0，不算一筆樣本
+    if (t.match)   stats.record(PerfStats::Match, t.match);
+    if (t.gravity) stats.record(PerfStats::Gravity, t.gravity);
+    if (t.refill)  stats.record(PerfStats::Refill, t.refill);
+    if (t.enemy)   stats.record(PerfStats::EnemyPhase, t.enemy);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// runEngine(): 連續 step()，直到需要等 UI 動畫 (Clearing) 或等玩家 (PlayerMove)
+//    Clearing 一次解完整串 cascade，交給 UI 播放；播完才回到 onCascadePlayed()
+////////////////////////////////////////////////////////////////////////////////
+void GameController::runEngine()
+{
+    for (;;) {
+        const GameEngine::Phase before = engine.phase();
+        if (before == GameEngine::Idle || before == GameEngine::PlayerMove ||
+            before == GameEngine::Clearing || before == GameEngine::Won ||
+            before == GameEngine::Lost)
+        {
+            break;
+        }
+
+        GameEngine::StepResult r = engine.step();
+        switch (r.event) {
+            case GameEngine::MatchesFound: {
+                const BitBoard::MatchResult &m = engine.lastMatch();
+                GameEvent e = GameEvent::make(GameEvent::MatchesFound);
+                e.addCleared(r.cells);
+                e.comboCount = quint16(r.comboCount);
+                for (int a = 0; a < BitBoard::ATTR_COUNT; ++a) {
+                    e.clearedCount[a] = quint16(BitBoard::count(m.attrMatched[a]));
+                }
+                events->post(e);
+                break;
+            }
+            case GameEngine::WaveCleared:
+                emit waveCleared();
+                break;
+            case GameEngine::GameWon:
+                finishInputLog();
+                emit gameWon();
+                break;
+            case GameEngine::GameLost:
+                finishInputLog();
+                emit gameLost();
+                break;
+            case GameEngine::None:
+            case GameEngine::DamageDealt:
+            case GameEngine::EnemyAttacked:
+                break;
+        }
+    }
+
+    if (engine.phase() == GameEngine::Clearing) {
+        GameEngine::StepResult r = engine.step();
+        pendingDamage = r.damage;
+
+        const GameEngine::Cascade &cas = engine.cascade();
+        GameEvent e = GameEvent::make(GameEvent::CascadeResolved);
+        for (int i = 0; i < cas.roundCount; ++i) {
+            e.addCleared(cas.rounds[i].cleared);
+        }
+        e.comboCount = quint16(cas.comboCount);
+        for (int a = 0; a < BitBoard::ATTR_COUNT; ++a) {
+            e.clearedCount[a] = quint16(cas.clearedCount[a]);
+        }
+        e.damage = r.damage;
+        e.cascade = &cas;
+        events->post(e);
+        return;
+    }
+
+    if (engine.phase() == GameEngine::PlayerMove) {
+        beginPlayerTurn();
+    }
+}
+
+quint32 GameController::missionTick() const
+{
+    return quint32(missionClock.elapsed());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// finishInputLog(): 記下結果，存到 <AppLocalData>/replays/
+////////////////////////////////////////////////////////////////////////////////
+void GameController::finishInputLog()
+{
+    TOS_TRACE_SCOPE("GameController::finishInputLog");
+    inputLog.finish(engine);
+
+    const QString dirPath = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)
+                            + "/replays";
+    if (!QDir().mkpath(dirPath)) {
+        qWarning() << "[GameController] cannot create" << dirPath;
+        return;
+    }
+
+    const QString fileName = QString("%1/mission%2_%3_%4.tosreplay")
+                                 .arg(dirPath)
+                                 .arg(inputLog.missionID)
+                                 .arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss"))
+                                 .arg(inputLog.seed, 8, 16, QChar('0'));
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly) || !ReplayWriter::write(inputLog, &file)) {
+        qWarning() << "[GameController] cannot write replay" << fileName;
+        return;
+    }
+    qDebug() << "[GameController] replay saved:" << fileName;
+}
@@ -0,0 +1,123 @@
+// GameController.h
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QVector>
+#include "GameEngine.h"
+#include "GameEventChannel.h"
+#include "HintEngine.h"
+#include "InputLog.h"
+#include "MatchTracker.h"
+
+/*
+ * GameController
+ *  - GUI 端的 client：持有 10 秒倒數 QTimer，把 GameEngine 的階段事件轉成 signal
+ *  - 遊戲規則本身都在 core 的 GameEngine，這裡只負責「何時 step()」
+ *  - 每局挑一個 mission 種子交給 engine，並把玩家的交換、倒數結束與時間記在 InputLog；
+ *    一局結束後以 ReplayWriter 存成 replays/ 下的 .tosreplay，可用 TOSSimulator --replay 無畫面、全速重播
+ *  - 每回合的事件 (回合開始、預覽、消除、cascade、傷害) 走 eventChannel()，UI 每幀取一次；
+ *    倒數到、換波、勝負這些流程切換仍是 signal
+ */
+class GameController : public QObject
+{
+    Q_OBJECT
+
+public:
+    // 盤面行列數
+    static constexpr int ROWS = GemBoard::ROWS;
+    static constexpr int COLS = GemBoard::COLS;
+
+    explicit GameController(QObject *parent = nullptr);
+    virtual ~GameController();
+
+    // 初始化：給 GameController 玩家角色指標陣列 + missionID
+    void init(const QVector<Character*> &playerChars, int missionID);
+
+    // 隊伍組成 (角色 ID + 總 HP)，寫進 InputLog 供重播時重建隊伍
+    void setPartySetup(const QVector<int> &team, int totalHP);
+
+    // 指定下一局的 mission 種子 (重現回報的問題用)；不指定則每局隨機
+    void setMissionSeed(quint32 seed);
+
+    // 開始 mission：產生三波 wave, 產生初始盤面, 啟動第一波
+    void startMission();
+
+    // 【新增以下兩個 getter，讓 MainWindow 拿到資料】
+    QVector<Enemy*> getCurrentWaveEnemies() const;
+    QVector<Enemy*> getNextWaveEnemies() const;     // 最後一波時為空
+    const GemBoard &getBoardMatrix() const;
+
+    // 底層規則引擎 (工具／測試可直接使用)
+    const GameEngine &getEngine() const;
+
+    // 本局目前為止的輸入紀錄
+    const InputLog &getInputLog() const;
+
+    // 給 GameStageWidget 的事件佇列
+    GameEventChannel *eventChannel() const;
+
+public slots:
+    // 轉珠途中交換相鄰兩格 (寫進輸入紀錄)
+    bool swapGems(int r1, int c1, int r2, int c2);
+
+    // 玩家放開符石 → 重新啟動倒數
+    void onPlayerSwapFinished();
+
+    // 啟動 10 秒倒數
+    void startMoveTimer();
+
+    // 倒數結束 → 開始判定消除
+    void onMoveTimeout();
+
+    // 轉珠輔助：提示改成整條拖動路徑 (倒數中切換時立刻重算)
+    void setDragAssist(bool enabled);
+
+    // UI 播完整串 cascade 動畫後呼叫 → 結算傷害
+    void onCascadePlayed();
+
+    // UI 完成「敵人受傷動畫」後，呼叫回 Controller
+    void onEnemiesAttacked();
+
+signals:
+    // 倒數到 → UI 禁止滑動，進入判定 (同步送出：拖曳中的符石要在 endMove() 前落定)
+    void moveTimeUp();
+
+    // 背景提示算好了 (只會是目前盤面的結果)
+    void hintReady(const HintEngine::Hint &hint);
+
+    // 本波 battle 全部清完
+    void waveCleared();
+
+    // 三波都打完 → Mission 勝利
+    void gameWon();
+
+    // 玩家全滅 → Mission 失敗
+    void gameLost();
+
+private:
+    // 連續 step() 直到需要等 UI 或等玩家為止
+    void advanceEngine();
+    void runEngine();
+    void recordPhaseTimes();
+    void beginPlayerTurn();
+    void requestHint();
+    quint32 missionTick() const;
+    void finishInputLog();
+
+private:
+    GameEngine                  engine;            // 遊戲規則核心
+    QTimer                     *moveTimer;         // 10 秒倒數
+    int                         pendingDamage;     // cascade 播完後才送出的傷害
+    HintEngine                 *hintEngine;        // 倒數期間在 worker thread 算提示
+    MatchTracker                dragMatches;       // 轉珠中的增量連線判定
+    GameEventChannel           *events;            // → GameStageWidget
+
+    InputLog                    inputLog;          // 本局輸入紀錄
+    QElapsedTimer               missionClock;      // 輸入的時間戳
+    QVector<int>                partyTeam;
+    int                         partyHP;
+    quint32                     presetSeed;
+    bool                        hasPresetSeed;
+};
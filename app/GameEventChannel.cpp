@@ -0,0 +1,110 @@
+// GameEventChannel.cpp
+#include "GameEventChannel.h"
+#include "FrameClock.h"
+#include <QDebug>
+
+static_assert((GameEventChannel::CAPACITY & (GameEventChannel::CAPACITY - 1)) == 0,
+              "capacity must be a power of two");
+
+GameEvent GameEvent::make(Type type)
+{
+    GameEvent e = GameEvent();
+    e.type = type;
+    return e;
+}
+
+void GameEvent::addCleared(BitBoard::Mask cleared)
+{
+    cells |= cleared;
+    for (int c = 0; c < BitBoard::COLS; ++c) {
+        columnDrop[c] += quint8(BitBoard::count(cleared & BitBoard::columnMask(c)));
+    }
+}
+
+MatchTracker::Preview GameEvent::preview() const
+{
+    MatchTracker::Preview p;
+    p.matched = cells;
+    p.comboCount = comboCount;
+    for (int a = 0; a < BitBoard::ATTR_COUNT; ++a) {
+        p.clearedCount[a] = clearedCount[a];
+    }
+    p.damage = damage;
+    return p;
+}
+
+GameEventChannel::GameEventChannel(QObject *parent)
+    : QObject(parent),
+      head(0),
+      tail(0),
+      framesRequested(false)
+{
+    connect(FrameClock::instance(), &FrameClock::frame, this, &GameEventChannel::onFrame);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// post(): 寫到 tail；還在佇列裡的預覽直接覆蓋，不另外排一筆
+////////////////////////////////////////////////////////////////////////////////
+bool GameEventChannel::post(const GameEvent &event)
+{
+    if (event.type == GameEvent::PreviewChanged && head != tail) {
+        GameEvent &last = ring[(tail - 1) & (CAPACITY - 1)];
+        if (last.type == GameEvent::PreviewChanged) {
+            last = event;
+            return true;
+        }
+    }
+
+    if (tail - head >= quint32(CAPACITY)) {
+        qWarning() << "[GameEventChannel] queue full, dropping event" << int(event.type);
+        return false;
+    }
+
+    ring[tail & (CAPACITY - 1)] = event;
+    ++tail;
+
+    if (!framesRequested) {
+        framesRequested = true;
+        FrameClock::instance()->requestFrames(this);
+    }
+    return true;
+}
+
+bool GameEventChannel::post(GameEvent::Type type)
+{
+    return post(GameEvent::make(type));
+}
+
+bool GameEventChannel::poll(GameEvent &out)
+{
+    if (head == tail) return false;
+    out = ring[head & (CAPACITY - 1)];
+    ++head;
+    return true;
+}
+
+bool GameEventChannel::isEmpty() const
+{
+    return head == tail;
+}
+
+void GameEventChannel::clear()
+{
+    head = tail = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// onFrame(): 一幀通知一次；consumer 處理途中又 post 的事件會在同一輪 poll() 取到
+////////////////////////////////////////////////////////////////////////////////
+void GameEventChannel::onFrame()
+{
+    if (!framesRequested) return;
+
+    if (head != tail) {
+        emit eventsReady();
+    }
+    if (head == tail) {
+        framesRequested = false;
+        FrameClock::instance()->release(this);
+    }
+}
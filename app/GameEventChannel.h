@@ -0,0 +1,78 @@
+// GameEventChannel.h
+#pragma once
+
+#include <QObject>
+#include "GameEngine.h"
+#include "MatchTracker.h"
+
+/*
+ * GameEvent
+ *  - GameController → GameStageWidget 的一筆事件，定長 POD，放進 ring buffer 不需要配置
+ *  - 消除格子一律是 30-bit 遮罩，另附各屬性格數與各欄的下落格數 (= 該欄補新的數量)
+ */
+struct GameEvent
+{
+    enum Type : quint8 {
+        PlayerTurnStarted,      // 開放轉珠
+        PreviewChanged,         // 轉珠中：cells / comboCount / clearedCount / damage
+        MatchesFound,           // 第一輪：cells / comboCount / clearedCount / columnDrop
+        CascadeResolved,        // 整串 cascade：同上 (全部輪數合計) + cascade
+        DamageDealt             // damage
+    };
+
+    Type            type;
+    quint8          columnDrop[BitBoard::COLS];         // 各欄消除 (上方下落) 的格數
+    quint16         comboCount;
+    quint16         clearedCount[BitBoard::ATTR_COUNT];
+    BitBoard::Mask  cells;
+    int             damage;
+    const GameEngine::Cascade *cascade;                 // 只在 CascadeResolved 有效；指向 engine 內部
+
+    static GameEvent make(Type type);
+
+    // 累加一輪的消除格子到 cells / columnDrop (clearedCount 由呼叫端填)
+    void addCleared(BitBoard::Mask cleared);
+
+    // 轉成 BoardWidget 的預覽 (PreviewChanged)
+    MatchTracker::Preview preview() const;
+};
+
+/*
+ * GameEventChannel
+ *  - 固定容量的 ring buffer：GameController post()，GameStageWidget 每幀 poll() 到空為止
+ *  - 有事件時才向 FrameClock 要幀，佇列清空後立即放掉；等待中的 PreviewChanged 會被
+ *    新的一筆覆蓋，轉珠時一幀最多一筆預覽
+ *  - 只在 GUI thread 使用；事件、signal 都不帶任何需要配置的參數，每回合沒有 heap 配置
+ */
+class GameEventChannel : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int CAPACITY = 64;             // 2 的次方
+
+    explicit GameEventChannel(QObject *parent = nullptr);
+
+    // 佇列滿時丟棄並回傳 false (正常一回合不會超過十筆)
+    bool post(const GameEvent &event);
+    bool post(GameEvent::Type type);
+
+    // 取出最舊的一筆；沒有事件回傳 false
+    bool poll(GameEvent &out);
+
+    bool isEmpty() const;
+    void clear();
+
+signals:
+    // 這一幀有事件待處理 (consumer 應 poll() 到空)
+    void eventsReady();
+
+private slots:
+    void onFrame();
+
+private:
+    GameEvent ring[CAPACITY];
+    quint32   head;     // 下一筆要讀的位置
+    quint32   tail;     // 下一筆要寫的位置
+    bool      framesRequested;
+};
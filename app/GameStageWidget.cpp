@@ -0,0 +1,601 @@
+// GameStageWidget.cpp
+#include "GameStageWidget.h"
+#include "AssetPreloader.h"
+#include "GameController.h"
+#include "MissionTable.h"
+#include "SpriteCache.h"
+#include "StallWatchdog.h"
+#include "Trace.h"
+#include <QShortcut>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QTimer>
+#include <QDebug>
+
+GameStageWidget::GameStageWidget(QWidget *parent)
+    : QWidget(parent),
+      frontRow(0),
+      perfOverlay(nullptr),
+      isPaused(false),
+      warmedUp(false),
+      dragAssist(false),
+      missionID(0),
+      eventChannel(nullptr)
+{
+    setupUI();
+    warmedUp = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// setSelectedCharacters(): 從 Prepare 階段拿到 6 個角色 ID (0 表示空格)
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::setSelectedCharacters(const QVector<int> &chars)
+{
+    selectedChars = chars;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// setMissionID(): 從 Prepare 階段拿到 missionID
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::setMissionID(int mission)
+{
+    missionID = mission;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// resetGame(): 清空所有區塊、重置角色區為 6 個灰底空格
+//    由 MainWindow 在每次切回遊戲畫面、或重新開始遊戲時呼叫
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::resetGame()
+{
+    StallWatchdog::Mark mark("GameStageWidget::resetGame");
+    // (1) 角色區 6 格都變回灰底空格
+    for (int i = 0; i < charLabels.size(); ++i) {
+        setCharacterSlot(i, 0);
+    }
+
+    // (2) 清空敵人區 (兩列都清，背景還沒排完的也停掉)
+    clearEnemyRows();
+
+    // (3) 清空符石區
+    clearBoard();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// initGame(): 真正把圖片貼到「角色／敵人／符石」上
+//    必須在 MainWindow::gotoGameStage() 裡，例如：先 resetGame() 再 initGame()
+//    才能把 selectedChars、currentWaveEnemies、board2D 一次畫上去
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::initGame()
+{
+    StallWatchdog::Mark mark("GameStageWidget::initGame");
+    TOS_TRACE_SCOPE("GameStageWidget::initGame");
+    PerfStats::Scope scope(PerfStats::WidgetRebuild);
+
+    // (1) 依序把 6 格位置顯示成「角色圖」或「灰底」(沿用同樣 6 個 label)
+    for (int i = 0; i < charLabels.size(); ++i) {
+        setCharacterSlot(i, selectedChars.value(i, 0));
+    }
+
+    // (2) 清空敵人區，後面由 showEnemies() 真正貼圖
+    clearEnemyRows();
+
+    // (3) 清空符石區，後面由 showBoard() 真正貼圖
+    clearBoard();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// setCharacterSlot(): 灰底用 palette + autoFillBackground 切換，不重設 stylesheet (不必重新 polish)
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::setCharacterSlot(int slot, int id)
+{
+    QLabel *lbl = charLabels[slot];
+    if (id > 0) {
+        // 圖已由 AssetPreloader 以同樣尺寸縮放好
+        const int size = AssetPreloader::PARTY_ICON_SIZE;
+        lbl->setAutoFillBackground(false);
+        lbl->setPixmap(SpriteCache::instance().pixmap(Character::iconPathFor(id), QSize(size, size),
+                                                      devicePixelRatioF()));
+    } else {
+        lbl->setAutoFillBackground(true);
+        lbl->clear();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// showEnemies(): 從 Controller 拿到一波 Enemy*，切到顯示這一波的那一列
+//    prefetchEnemies() 已經排好 (或排了一部分) 同一批敵人時，只補完剩下的再切換；
+//    否則在隱藏的那一列當場排好。換下來的那一列留到下一次 prefetchEnemies() 才清
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::showEnemies(const QVector<Enemy*> &enemies)
+{
+    StallWatchdog::Mark mark("GameStageWidget::showEnemies");
+    TOS_TRACE_SCOPE("GameStageWidget::showEnemies");
+    PerfStats::Scope scope(PerfStats::WidgetRebuild);
+
+    EnemyRow &back = enemyRows[1 - frontRow];
+    if (back.enemies != enemies) {
+        clearEnemyRow(back);
+        back.enemies = enemies;
+    }
+    prefetchTimer->stop();
+    buildEnemyRow(back, back.enemies.size());
+
+    frontRow = 1 - frontRow;
+    enemyStack->setCurrentWidget(back.page);
+    settingButton->raise();
+}
+
+void GameStageWidget::prefetchEnemies(const QVector<Enemy*> &enemies)
+{
+    EnemyRow &back = enemyRows[1 - frontRow];
+    if (back.enemies == enemies && back.shown == enemies.size()) return;
+
+    clearEnemyRow(back);
+    back.enemies = enemies;
+    if (!enemies.isEmpty()) prefetchTimer->start();
+}
+
+bool GameStageWidget::isPrefetching() const
+{
+    return prefetchTimer->isActive();
+}
+
+void GameStageWidget::onPrefetchTick()
+{
+    StallWatchdog::Mark mark("GameStageWidget::onPrefetchTick");
+    TOS_TRACE_SCOPE("GameStageWidget::onPrefetchTick");
+    if (buildEnemyRow(enemyRows[1 - frontRow], PREFETCH_BATCH)) {
+        prefetchTimer->stop();
+    }
+}
+
+void GameStageWidget::clearEnemyRow(EnemyRow &row)
+{
+    for (int i = 0; i < row.shown; ++i) {
+        row.labels[i]->hide();
+    }
+    row.shown = 0;
+    row.enemies.clear();
+}
+
+void GameStageWidget::clearEnemyRows()
+{
+    prefetchTimer->stop();
+    clearEnemyRow(enemyRows[0]);
+    clearEnemyRow(enemyRows[1]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// growEnemyRow(): slot 不夠時才配置 (先隱藏)
+//    每個 slot 的 stretch 都是 1 且置中，顯示中的敵人自然在水平方向上均勻分佈
+//    setupUI() 先配置到 mission 表裡最大的一波，之後照常遊玩不會再配置
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::growEnemyRow(EnemyRow &row, int count)
+{
+    const int size = AssetPreloader::ENEMY_ICON_SIZE;
+    while (row.labels.size() < count) {
+        QLabel *lbl = new QLabel(row.page);
+        lbl->setFixedSize(size, size);
+        lbl->setAlignment(Qt::AlignCenter);
+        lbl->hide();
+        row.layout->addWidget(lbl, 1, Qt::AlignCenter);
+        row.labels.append(lbl);
+
+        if (warmedUp) PerfStats::instance().count(PerfStats::WidgetAllocations);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// buildEnemyRow(): 接著上次排到的地方，再把最多 budget 個 slot 換成這一波的敵人
+////////////////////////////////////////////////////////////////////////////////
+bool GameStageWidget::buildEnemyRow(EnemyRow &row, int budget)
+{
+    const int target = row.enemies.size();
+    if (row.shown >= target) return true;
+
+    growEnemyRow(row, qMin(target, row.shown + budget));
+    const int end = qMin(target, row.shown + budget);
+    for (int i = row.shown; i < end; ++i) {
+        Enemy *e = row.enemies[i];
+        QLabel *lbl = row.labels[i];
+        if (e) {
+            lbl->setPixmap(SpriteCache::instance().pixmap(e->getIconPath(), lbl->size(),
+                                                          devicePixelRatioF()));
+        } else {
+            lbl->clear();
+        }
+        lbl->show();
+    }
+    row.shown = end;
+    return row.shown == target;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// showBoard(): 從 Controller 拿到 6×5 盤面，交給 BoardWidget 只重畫有變動的格子
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::showBoard(const GemBoard &board)
+{
+    StallWatchdog::Mark mark("GameStageWidget::showBoard");
+    TOS_TRACE_SCOPE("GameStageWidget::showBoard");
+    boardWidget->setBoard(board);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// clearBoard(): 把盤面清成黑底空格 (不再重建任何 widget)
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::clearBoard()
+{
+    boardWidget->clearBoard();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// setEventChannel() / drainEvents(): Controller 的事件每幀在這裡一次取完
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::setEventChannel(GameEventChannel *channel)
+{
+    if (eventChannel) {
+        disconnect(eventChannel, nullptr, this, nullptr);
+    }
+    eventChannel = channel;
+    if (eventChannel) {
+        connect(eventChannel, &GameEventChannel::eventsReady,
+                this, &GameStageWidget::drainEvents);
+    }
+}
+
+void GameStageWidget::drainEvents()
+{
+    StallWatchdog::Mark mark("GameStageWidget::drainEvents");
+    TOS_TRACE_SCOPE("GameStageWidget::drainEvents");
+    GameEvent e;
+    while (eventChannel && eventChannel->poll(e)) {
+        switch (e.type) {
+            case GameEvent::PlayerTurnStarted:
+                onPlayerTurnStarted();
+                break;
+            case GameEvent::PreviewChanged:
+                // 倒數到之後才取到的預覽已經過時 (onMoveTimeUp() 同步清掉了預覽)
+                if (boardWidget->isInputEnabled()) showPreview(e.preview());
+                break;
+            case GameEvent::MatchesFound:
+                onMatchesFound(e);
+                break;
+            case GameEvent::CascadeResolved:
+                playCascade(*e.cascade);
+                break;
+            case GameEvent::DamageDealt:
+                onDealDamage(e.damage);
+                break;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// onPlayerTurnStarted(): 輪到玩家 → 開放轉珠
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::onPlayerTurnStarted()
+{
+    TOS_TRACE_ASYNC_END("turn", 1);
+    boardWidget->setInputEnabled(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// onMoveTimeUp(): Controller 倒數到 → UI 禁止滑動、進入消除判定
+//    拖曳中的符石直接放在目前的格子
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::onMoveTimeUp()
+{
+    qDebug() << "[GameStageWidget] onMoveTimeUp()";
+    boardWidget->setInputEnabled(false);
+    boardWidget->setHint(0);
+    boardWidget->setPreview(MatchTracker::Preview());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// showHint(): 背景提示算好 → 框出建議交換的兩格；轉珠輔助時框出起點並畫出整條路徑
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::showHint(const HintEngine::Hint &hint)
+{
+    if (!hint.valid) {
+        boardWidget->setHint(0);
+        return;
+    }
+    if (hint.path.length > 0) {
+        QVector<int> cells;
+        cells.reserve(hint.path.length + 1);
+        for (int i = 0; i <= hint.path.length; ++i) {
+            cells.append(hint.path.cellAt(i));
+        }
+        boardWidget->setHint(BitBoard::bit(hint.r1, hint.c1), cells);
+        return;
+    }
+    boardWidget->setHint(BitBoard::bit(hint.r1, hint.c1) | BitBoard::bit(hint.r2, hint.c2));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// showPreview(): 轉珠途中每次交換 → 更新會消除的格子與 combo／傷害
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::showPreview(const MatchTracker::Preview &preview)
+{
+    boardWidget->setPreview(preview);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// onMatchesFound(): Controller 找到第一輪 matched 格子
+//    消除動畫改由 playCascade() 依 engine 的步驟列表一次播完
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::onMatchesFound(const GameEvent &event)
+{
+    TOS_TRACE_SCOPE("GameStageWidget::onMatchesFound");
+    qDebug() << "[GameStageWidget] onMatchesFound() cells =" << BitBoard::count(event.cells)
+             << "combo =" << event.comboCount;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// playCascade(): 播放整串 cascade，播完後通知 Controller 結算傷害
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::playCascade(const GameEngine::Cascade &cascade)
+{
+    TOS_TRACE_SCOPE("GameStageWidget::playCascade");
+    qDebug() << "[GameStageWidget] playCascade() rounds =" << cascade.roundCount
+             << "combo =" << cascade.comboCount;
+    boardWidget->playCascade(cascade);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// onDealDamage(): Controller 回傳 totalDamage → UI 更新敵人血量、受傷動畫
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::onDealDamage(int totalDamage)
+{
+    TOS_TRACE_SCOPE("GameStageWidget::onDealDamage");
+    qDebug() << "[GameStageWidget] onDealDamage() dmg =" << totalDamage;
+    // TODO: 更新畫面上每隻敵人的 HP (可自行寫受傷動畫)
+    TOS_TRACE_ASYNC_BEGIN("enemyHitWait", 1);
+    QTimer::singleShot(200, [this]() {
+        StallWatchdog::Mark mark("GameStageWidget::onDealDamage singleShot");
+        TOS_TRACE_ASYNC_END("enemyHitWait", 1);
+        emit enemiesAttacked();
+    });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// onWaveCleared(): Controller 發射 waveCleared → 等待下一波
+//    不拆任何 widget：下一波的敵人列已由 prefetchEnemies() 在背景排好，
+//    接著 MainWindow 呼叫 showEnemies() 切換列、showBoard() 直接把盤面換成新的一盤
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::onWaveCleared()
+{
+    StallWatchdog::Mark mark("GameStageWidget::onWaveCleared");
+    TOS_TRACE_SCOPE("GameStageWidget::onWaveCleared");
+    qDebug() << "[GameStageWidget] onWaveCleared()";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 模擬勝利 / 模擬失敗：直接發出 gameOver()
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::onFakeWinButtonClicked()
+{
+    emit gameOver(true);
+}
+
+void GameStageWidget::onFakeLoseButtonClicked()
+{
+    emit gameOver(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 設定按鈕：發出 pauseRequested()
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::onSettingClicked()
+{
+    emit pauseRequested();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 暫停遊戲：暫時停掉任何互動或動畫
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::pauseGame()
+{
+    qDebug() << "[GameStageWidget] pauseGame()";
+    isPaused = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 恢復遊戲：重新允許互動或動畫
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::resumeGame()
+{
+    qDebug() << "[GameStageWidget] resumeGame()";
+    isPaused = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// setupUI(): 建立「敵人區／設定按鈕／模擬按鈕／角色區／符石區」的佈局
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::setupUI()
+{
+    // 主垂直佈局 (總高 540×960)
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(0, 0, 0, 0);
+    mainLayout->setSpacing(0);
+
+    // ─────── 1. 敵人區 ───────────────────────────────────
+    enemyArea = new QWidget(this);
+    enemyArea->setFixedSize(540, 390);
+    enemyArea->setStyleSheet("background-color: #EFEFEF;");
+
+    // 兩列敵人疊在一起：各自是一個水平佈局，敵人 QLabel 都放在列裡
+    enemyStack = new QStackedLayout(enemyArea);
+    for (EnemyRow &row : enemyRows) {
+        row.page = new QWidget(enemyArea);
+        row.layout = new QHBoxLayout(row.page);
+        row.layout->setContentsMargins(10,10,10,10);
+        row.layout->setSpacing(20);
+        row.shown = 0;
+        enemyStack->addWidget(row.page);
+    }
+    enemyStack->setCurrentWidget(enemyRows[frontRow].page);
+
+    // 敵人 slot 一次配置到 mission 表裡最大的一波 (兩列各一份)
+    {
+        const MissionTable &table = MissionTable::shared();
+        int maxEnemies = 0;
+        for (int id = 1; id <= table.maxMissionID(); ++id) {
+            const MissionTable::MissionDef *m = table.mission(id);
+            if (!m) continue;
+            for (int w = 0; w < m->waveCount; ++w) {
+                maxEnemies = qMax(maxEnemies, int(table.wave(*m, w).enemyCount));
+            }
+        }
+        for (EnemyRow &row : enemyRows) {
+            growEnemyRow(row, maxEnemies);
+        }
+    }
+
+    prefetchTimer = new QTimer(this);
+    prefetchTimer->setInterval(0);
+    connect(prefetchTimer, &QTimer::timeout, this, &GameStageWidget::onPrefetchTick);
+
+    // 把 enemyArea 加到主畫面（靠上方）
+    mainLayout->addWidget(enemyArea);
+
+    // 設定按鈕 (齒輪)：大小 30×30，絕對定位到右上 (500,10)
+    settingButton = new QPushButton(enemyArea);
+    settingButton->setIcon(QIcon(":/icons/setting.png")); // 你自己準備齒輪 icon
+    settingButton->setIconSize(QSize(24,24));
+    settingButton->setFixedSize(30,30);
+    settingButton->move(500, 10);
+    settingButton->raise();
+    connect(settingButton, &QPushButton::clicked,
+            this, &GameStageWidget::onSettingClicked);
+
+    mainLayout->addWidget(enemyArea);
+
+    // ------------------------------------------------------------------------
+    // (2) 模擬勝利 / 模擬失敗 / 下一波 按鈕
+    // ------------------------------------------------------------------------
+    QWidget *buttonArea = new QWidget(this);
+    buttonArea->setFixedHeight(50);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout(buttonArea);
+    buttonLayout->setContentsMargins(10, 5, 10, 5);
+    buttonLayout->setSpacing(20);
+
+    fakeWinBtn       = new QPushButton(tr("Sim Win"), buttonArea);
+    fakeLoseBtn      = new QPushButton(tr("Sim Lose"), buttonArea);
+    nextBattleButton = new QPushButton(tr("Next Battle"), buttonArea);
+
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(fakeWinBtn);
+    buttonLayout->addWidget(fakeLoseBtn);
+    buttonLayout->addWidget(nextBattleButton);
+    buttonLayout->addStretch();
+
+    connect(fakeWinBtn, &QPushButton::clicked,
+            this, &GameStageWidget::onFakeWinButtonClicked);
+    connect(fakeLoseBtn, &QPushButton::clicked,
+            this, &GameStageWidget::onFakeLoseButtonClicked);
+    connect(nextBattleButton, &QPushButton::clicked,
+            this, &GameStageWidget::onWaveCleared);
+
+    mainLayout->addWidget(buttonArea);
+
+    statusBar = new QProgressBar(this);
+    statusBar->setFixedSize(530, 20);
+    statusBar->setAlignment(Qt::AlignCenter);
+    statusBar->setStyleSheet(
+        "QProgressBar {"
+        "  background-color: #8B4513;"    // 棕色
+        "  border: 1px solid #000000;"
+        "}"
+        "QProgressBar::chunk {"
+        "  background-color: #FF69B4;"    // 粉紅
+        "}"
+    );
+    statusBar->setRange(0, 100);
+    statusBar->setValue(70);
+
+    // 外層用一個 QWidget 再搭 QHBoxLayout 置中
+    QWidget *statusContainer = new QWidget(this);
+    statusContainer->setFixedHeight(30);
+    QHBoxLayout *hbox = new QHBoxLayout(statusContainer);
+    hbox->setContentsMargins(0,0,0,0);
+    hbox->addStretch();
+    hbox->addWidget(statusBar);
+    hbox->addStretch();
+    mainLayout->addWidget(statusContainer);
+
+
+    // ------------------------------------------------------------------------
+    // (3) 角色區 (6 個灰底格子，後續 initGame() 會貼圖)
+    // ------------------------------------------------------------------------
+    QWidget *charArea = new QWidget(this);
+    charArea->setFixedHeight(80);
+
+    charLayout = new QGridLayout(charArea);
+    charLayout->setContentsMargins(5, 5, 5, 5);
+    charLayout->setSpacing(10);
+
+    // 6 個 label 整場共用；空格用 palette 畫灰底 (見 setCharacterSlot())
+    QPalette emptySlot;
+    emptySlot.setColor(QPalette::Window, QColor("#555555"));
+    for (int i = 0; i < 6; ++i) {
+        QLabel *lbl = new QLabel(charArea);
+        lbl->setFixedSize(AssetPreloader::PARTY_ICON_SIZE, AssetPreloader::PARTY_ICON_SIZE);
+        lbl->setPalette(emptySlot);
+        lbl->setAutoFillBackground(true);                  // 預設灰底
+        charLayout->addWidget(lbl, 0, i);
+        charLabels.append(lbl);
+    }
+
+    mainLayout->addWidget(charArea);
+
+    // ------------------------------------------------------------------------
+    // (4) 符石區 (6×5，每格 90×90，初始黑底)，單一 widget 自行繪製
+    // ------------------------------------------------------------------------
+    boardWidget = new BoardWidget(this);
+    connect(boardWidget, &BoardWidget::gemDragged,
+            this, &GameStageWidget::gemsSwapped);
+    connect(boardWidget, &BoardWidget::dragFinished, this, [this](int swapCount) {
+        if (swapCount > 0) emit swapFinished();
+    });
+    connect(boardWidget, &BoardWidget::cascadeFinished,
+            this, &GameStageWidget::cascadePlayed);
+    mainLayout->addWidget(boardWidget);
+
+    // ------------------------------------------------------------------------
+    // (5) 效能 HUD (不在 layout 裡，疊在右上角)：F3 開關、F4 存 CSV
+    // ------------------------------------------------------------------------
+    perfOverlay = new PerfOverlay(this);
+    QShortcut *toggleHud = new QShortcut(QKeySequence(Qt::Key_F3), this);
+    connect(toggleHud, &QShortcut::activated, perfOverlay, &PerfOverlay::toggle);
+    QShortcut *dumpHud = new QShortcut(QKeySequence(Qt::Key_F4), this);
+    connect(dumpHud, &QShortcut::activated, perfOverlay, &PerfOverlay::dumpCsv);
+
+    // F6：轉珠輔助開關 (提示由 Controller 重算，下一次 showHint() 換成路徑)
+    QShortcut *toggleAssist = new QShortcut(QKeySequence(Qt::Key_F6), this);
+    connect(toggleAssist, &QShortcut::activated, this, [this]() {
+        dragAssist = !dragAssist;
+        emit dragAssistToggled(dragAssist);
+    });
+
+#ifdef TOS_TRACE
+    // 以 CONFIG+=trace 建置時：F5 把目前的 trace 存成 JSON
+    QShortcut *dumpTrace = new QShortcut(QKeySequence(Qt::Key_F5), this);
+    connect(dumpTrace, &QShortcut::activated, []() {
+        qDebug() << "[GameStageWidget] trace written to" << Trace::writeDefault();
+    });
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// resizeEvent(): 效能 HUD 固定在右上角
+////////////////////////////////////////////////////////////////////////////////
+void GameStageWidget::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    if (perfOverlay) {
+        perfOverlay->move(width() - perfOverlay->width() - 8, 8);
+    }
+}
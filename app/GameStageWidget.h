@@ -0,0 +1,169 @@
+// GameStageWidget.h
+#pragma once
+
+#include <QWidget>
+#include <QVector>
+#include <QPair>
+#include <QLabel>
+#include <QPushButton>
+#include <QGridLayout>
+#include <QStackedLayout>
+#include <QProgressBar>
+#include <QTimer>
+#include "GemBoard.h"
+#include "BoardWidget.h"
+#include "GameEventChannel.h"
+#include "PerfOverlay.h"
+#include "HintEngine.h"
+#include "Enemy.h"
+
+class GameStageWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit GameStageWidget(QWidget *parent = nullptr);
+
+    // 從 Prepare 階段傳來：6 格角色 ID (0 表示空格)
+    void setSelectedCharacters(const QVector<int> &chars);
+    void setMissionID(int mission);
+
+    // 初始化與重置：MainWindow 在每次切到遊戲畫面時都要呼叫
+    void resetGame();
+    void initGame();
+
+    // UI 暫停／恢復
+    void pauseGame();
+    void resumeGame();
+
+    // 顯示敵人、顯示盤面符石
+    void showEnemies(const QVector<Enemy*> &enemies);
+
+    // 下一波的敵人先在背景 (每個事件迴圈空檔排 PREFETCH_BATCH 隻) 排進隱藏的那一列；
+    // 之後 showEnemies() 遇到同一批敵人只是切換
+    void prefetchEnemies(const QVector<Enemy*> &enemies);
+    bool isPrefetching() const;
+    void showBoard(const GemBoard &board);
+
+    // 把盤面清成黑底空格
+    void clearBoard();
+
+    // 在一般遊戲中，用來設定「當前血量／最高血量」
+    void setHealth(int currentHP, int maxHP);
+
+    // 進入「轉珠倒數」模式，傳入剩餘秒數(倒數秒數由右向左消失)
+    void startCountdown(int seconds);
+
+    // 停止倒數，恢復成顯示血量的模式 (或直接隱藏)
+    void stopCountdown();
+
+    // Controller 的事件佇列；每幀取一次
+    void setEventChannel(GameEventChannel *channel);
+
+signals:
+    // 遊戲結束（true：玩家勝，false：玩家敗）
+    void gameOver(bool playerWon);
+
+    // 玩家按下左上角設定，此信號由 MainWindow 接去 Pause 畫面
+    void pauseRequested();
+
+    // UI → Controller
+    void gemsSwapped(int r1, int c1, int r2, int c2);   // 轉珠途中每跨一格
+    void swapFinished();                                // 放開符石
+    void cascadePlayed();
+    void enemiesAttacked();
+    void dragAssistToggled(bool enabled);              // F6：提示改成整條拖動路徑
+
+public slots:
+    // Controller → UI
+    void onMoveTimeUp();
+    void showHint(const HintEngine::Hint &hint);
+    void onWaveCleared();
+
+protected:
+    void resizeEvent(QResizeEvent *event) override;
+
+private slots:
+    void onSettingClicked();
+    void onFakeWinButtonClicked();
+    void onFakeLoseButtonClicked();
+    // 倒數計時器每秒觸發，用來更新進度顯示
+    void onCountdownTimeout();
+    // 取完 eventChannel 裡這一幀的事件
+    void drainEvents();
+    // 繼續排隱藏的那一列敵人
+    void onPrefetchTick();
+
+private:
+    static constexpr int PREFETCH_BATCH = 16;
+
+    // 敵人區的一列 (兩列輪流：一列顯示中，另一列在背景排下一波)
+    //    labels 是這一列的 slot：只會增加、不會刪除，換波時隱藏／顯示並換圖
+    struct EnemyRow
+    {
+        QWidget          *page;
+        QHBoxLayout      *layout;
+        QVector<QLabel*>  labels;       // 隱藏的 label 不佔版面
+        QVector<Enemy*>   enemies;      // 這一列要顯示的敵人
+        int               shown;        // 前 shown 個 slot 已經對應到 enemies
+    };
+
+    void setupUI();
+
+    // 角色區第 slot 格：id > 0 貼角色圖，否則灰底空格
+    void setCharacterSlot(int slot, int id);
+
+    // 隱藏一列的所有 slot；排一列最多 budget 隻，回傳是否已經排完
+    void clearEnemyRow(EnemyRow &row);
+    bool buildEnemyRow(EnemyRow &row, int budget);
+    void clearEnemyRows();
+    void growEnemyRow(EnemyRow &row, int count);
+
+    // eventChannel 的各種事件
+    void onPlayerTurnStarted();
+    void onMatchesFound(const GameEvent &event);
+    void playCascade(const GameEngine::Cascade &cascade);
+    void showPreview(const MatchTracker::Preview &preview);
+    void onDealDamage(int totalDamage);
+
+    // ===== UI 成員變數 =====
+    // (1) 敵人區
+    QWidget                  *enemyArea;
+    QStackedLayout           *enemyStack;    // 兩列敵人疊在一起，一次只顯示一列
+    EnemyRow                  enemyRows[2];
+    int                       frontRow;      // 顯示中的那一列
+    QTimer                   *prefetchTimer; // 0 ms：事件迴圈一有空就排下一批
+
+    // (2) 按鈕：模擬勝利／模擬失敗／下一波
+    QPushButton              *fakeWinBtn;
+    QPushButton              *fakeLoseBtn;
+    QPushButton              *nextBattleButton;
+
+    // (3) 左上角設定按鈕
+    QPushButton              *settingButton;
+
+    // (4) status bar
+    QProgressBar              *statusBar;       // 顯示血量或倒數進度的條
+    bool                       inCountdownMode; // false = 顯示血量模式；true = 倒數模式
+    int                        countdownRemain; // 倒數剩餘秒數
+    QTimer                    *countdownTimer;  // 每秒觸發 onCountdownTimeout()
+
+    // (5) 角色區：6 格
+    QGridLayout              *charLayout;
+    QVector<QLabel*>          charLabels;    // 6 個 QLabel
+
+
+    // (6) 符石區：6×5 格，由 BoardWidget 自行繪製
+    BoardWidget              *boardWidget;
+
+    // (7) 效能 HUD
+    PerfOverlay              *perfOverlay;
+
+    // 狀態、資料
+    bool                      isPaused;
+    QVector<int>              selectedChars; // 從 Prepare 拿到的 6 個 ID
+    bool                      warmedUp;      // 畫面建好之後再配置 widget 就記進 PerfStats::WidgetAllocations
+    bool                      dragAssist;    // 轉珠輔助 (F6)
+    int                       missionID;
+    GameEventChannel         *eventChannel;  // 不接管所有權
+};
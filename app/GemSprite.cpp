@@ -0,0 +1,221 @@
+// GemSprite.cpp
+#include "GemSprite.h"
+#include "SpriteCache.h"
+#include <algorithm>
+#include <initializer_list>
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+////////////////////////////////////////////////////////////////////////////////
+
+GemSprite::GemSprite()
+    : gem(Gem::empty()),
+      row(0),
+      col(0),
+      state(Gem::Idle),
+      fallDistance(0),
+      pixmapDpr(1.0),
+      animStartMs(0),
+      animDurationMs(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 圖檔路徑
+////////////////////////////////////////////////////////////////////////////////
+
+QString GemSprite::iconPathFor(Gem::Attribute type, Gem::EffectStatus effect)
+{
+    const char *name = "water";
+    switch (type) {
+        case Gem::Water: name = "water"; break;
+        case Gem::Fire:  name = "fire";  break;
+        case Gem::Earth: name = "earth"; break;
+        case Gem::Light: name = "light"; break;
+        case Gem::Dark:  name = "dark";  break;
+    }
+
+    switch (effect) {
+        case Gem::Burning:
+            return QString(":/Bstone/dataset/runestone/burning_%1_stone.png").arg(name);
+        case Gem::Weathered:
+            return QString(":/Wstone/dataset/runestone/weathered_%1_stone.png").arg(name);
+        case Gem::Normal:
+        default:
+            return QString(":/Nstone/dataset/runestone/%1_stone.png").arg(name);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// setGem(): 指向新的符石；只有外觀改變時才向 SpriteCache 換圖
+////////////////////////////////////////////////////////////////////////////////
+
+void GemSprite::setGem(const Gem &g, int r, int c, qreal dpr)
+{
+    if (!g.looksLike(gem) || !qFuzzyCompare(dpr, pixmapDpr)) {
+        if (g.isEmpty()) {
+            iconPath.clear();
+            pixmap = QPixmap();
+        } else {
+            iconPath = iconPathFor(g.getType(), g.getEffectStatus());
+            pixmap = SpriteCache::instance().gemPixmap(g.getType(), g.getEffectStatus(),
+                                                       QSize(Gem::TILE_SIZE, Gem::TILE_SIZE), dpr);
+        }
+        pixmapDpr = dpr;
+    }
+
+    gem = g;
+    row = r;
+    col = c;
+    state = Gem::Idle;
+    fallDistance = 0;
+    currentPos = QPointF(c * Gem::TILE_SIZE, r * Gem::TILE_SIZE);
+    startPos = currentPos;
+    targetPos = currentPos;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Getter
+////////////////////////////////////////////////////////////////////////////////
+
+const Gem &GemSprite::getGem() const
+{
+    return gem;
+}
+
+int GemSprite::getRow() const
+{
+    return row;
+}
+
+int GemSprite::getCol() const
+{
+    return col;
+}
+
+Gem::State GemSprite::getState() const
+{
+    return state;
+}
+
+QString GemSprite::getIconPath() const
+{
+    return iconPath;
+}
+
+const QPixmap &GemSprite::getPixmap() const
+{
+    return pixmap;
+}
+
+QPointF GemSprite::getCurrentPos() const
+{
+    return currentPos;
+}
+
+QRect GemSprite::getRect() const
+{
+    return QRect(currentPos.toPoint(), QSize(Gem::TILE_SIZE, Gem::TILE_SIZE));
+}
+
+bool GemSprite::isAnimating() const
+{
+    return state == Gem::Swapping || state == Gem::Falling;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Easing
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+    // 交換：先快後慢
+    inline qreal easeOutCubic(qreal t)
+    {
+        const qreal u = 1.0 - t;
+        return 1.0 - u * u * u;
+    }
+
+    // 下落：像重力一樣越掉越快
+    inline qreal easeInQuad(qreal t)
+    {
+        return t * t;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Swap Animation
+////////////////////////////////////////////////////////////////////////////////
+
+void GemSprite::swapWith(GemSprite *other, qint64 nowMs)
+{
+    if (!other) return;
+
+    // 交換 row/col
+    std::swap(this->row, other->row);
+    std::swap(this->col, other->col);
+
+    // 從目前位置出發，設定新的目標像素座標
+    for (GemSprite *s : { this, other }) {
+        s->startPos = s->currentPos;
+        s->targetPos = QPointF(s->col * Gem::TILE_SIZE, s->row * Gem::TILE_SIZE);
+        s->animStartMs = nowMs;
+        s->animDurationMs = SWAP_DURATION_MS;
+        s->state = Gem::Swapping;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Fall Animation
+////////////////////////////////////////////////////////////////////////////////
+
+void GemSprite::startFalling(int numRows, qint64 nowMs)
+{
+    if (numRows <= 0) return;
+
+    fallDistance = numRows;
+    state = Gem::Falling;
+    startPos = currentPos;
+    targetPos = QPointF(col * Gem::TILE_SIZE, (row + fallDistance) * Gem::TILE_SIZE);
+    animStartMs = nowMs;
+    animDurationMs = numRows * FALL_MS_PER_ROW;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// advance(): 以經過時間內插位置，與呼叫頻率無關
+////////////////////////////////////////////////////////////////////////////////
+
+bool GemSprite::advance(qint64 nowMs)
+{
+    if (!isAnimating()) return false;
+
+    qreal t = animDurationMs > 0 ? qreal(nowMs - animStartMs) / animDurationMs : 1.0;
+    t = qBound(qreal(0.0), t, qreal(1.0));
+
+    const qreal k = (state == Gem::Falling) ? easeInQuad(t) : easeOutCubic(t);
+    currentPos = startPos + (targetPos - startPos) * k;
+
+    if (t < 1.0) return true;
+
+    // 到達目標，切回 Idle
+    currentPos = targetPos;
+    if (state == Gem::Falling) {
+        row += fallDistance;
+        fallDistance = 0;
+    }
+    state = Gem::Idle;
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Paint
+////////////////////////////////////////////////////////////////////////////////
+
+void GemSprite::paint(QPainter *painter) const
+{
+    if (!painter) return;
+
+    // 只要 pixmap 已載入，就畫在 currentPos
+    if (!pixmap.isNull()) {
+        painter->drawPixmap(currentPos.toPoint(), pixmap);
+    }
+}
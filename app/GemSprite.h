@@ -0,0 +1,74 @@
+// GemSprite.h
+#pragma once
+
+#include <QPixmap>
+#include <QPointF>
+#include <QRect>
+#include <QPainter>
+#include <QString>
+#include "Gem.h"
+
+/*
+ * GemSprite
+ *  - 一格符石的繪製狀態：圖資、畫面座標、交換／下落動畫
+ *  - 動畫以 FrameClock 的時間 (毫秒) 做 easing 內插，與呼叫頻率無關
+ *  - 由畫面端以固定數量 (每格一個) 持有並重複使用，不隨盤面資料 new/delete
+ *  - 圖資由 SpriteCache 提供，setGem() 只有在外觀改變時才換 pixmap (指標複製)
+ */
+class GemSprite
+{
+public:
+    // 交換動畫時間、下落每格時間（毫秒）
+    static constexpr int SWAP_DURATION_MS = 120;
+    static constexpr int FALL_MS_PER_ROW  = 60;
+
+    GemSprite();
+
+    // 依屬性、效果取得符石圖檔路徑
+    static QString iconPathFor(Gem::Attribute type, Gem::EffectStatus effect);
+
+    // 把這個 sprite 指向 (row,col) 上的符石；dpr 為畫面的 device pixel ratio
+    void setGem(const Gem &gem, int row, int col, qreal dpr = 1.0);
+
+    // Getter
+    const Gem     &getGem() const;
+    int            getRow() const;
+    int            getCol() const;
+    Gem::State     getState() const;
+    QString        getIconPath() const;    // 回傳符石圖示路徑
+    const QPixmap &getPixmap() const;
+    QPointF        getCurrentPos() const;
+    QRect          getRect() const;        // 目前畫面上佔的矩形
+    bool           isAnimating() const;
+
+    // 交換兩顆符石：交換 row/col，並設置動畫起點與終點 (nowMs 為動畫開始時間)
+    void swapWith(GemSprite *other, qint64 nowMs);
+
+    // 開始下落：參數為要下落的格數
+    void startFalling(int numRows, qint64 nowMs);
+
+    // 依目前時間更新位置；回傳是否仍在動畫中
+    bool advance(qint64 nowMs);
+
+    // 繪製此符石
+    void paint(QPainter *painter) const;
+
+private:
+    Gem          gem;             // 目前顯示的符石資料
+
+    int          row;             // 邏輯格子列索引
+    int          col;             // 邏輯格子欄索引
+
+    Gem::State   state;           // 動畫狀態
+    int          fallDistance;    // 剩餘下落格數
+
+    QString      iconPath;        // 圖檔路徑
+    QPixmap      pixmap;          // SpriteCache 給的圖資 (已縮放成 TILE_SIZE)
+    qreal        pixmapDpr;       // pixmap 對應的 device pixel ratio
+
+    QPointF      startPos;        // 動畫起點 (像素)
+    QPointF      currentPos;      // 目前畫面座標 (像素)
+    QPointF      targetPos;       // 目標畫面座標 (像素)
+    qint64       animStartMs;     // 動畫開始時間
+    int          animDurationMs;  // 動畫長度
+};
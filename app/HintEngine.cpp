@@ -0,0 +1,136 @@
+// HintEngine.cpp
+#include "HintEngine.h"
+#include "DragSolver.h"
+#include <QtConcurrent>
+
+HintEngine::HintEngine(QObject *parent)
+    : QObject(parent),
+      generation(new QAtomicInt(0)),
+      pendingToken(-1),
+      dragAssist(false)
+{
+    connect(&watcher, &QFutureWatcher<Hint>::finished, this, &HintEngine::onFinished);
+}
+
+HintEngine::~HintEngine()
+{
+    // worker 會在下一個交換時發現 generation 改變而結束；
+    // 它們各自持有 generation，不必等 (也等不到被 setFuture() 換掉的舊 future)
+    cancel();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// request(): 作廢前一次計算，以目前盤面重新開始
+////////////////////////////////////////////////////////////////////////////////
+void HintEngine::request(const GemBoard &board, const Combatants &party, int defender)
+{
+    const int token = generation->fetchAndAddOrdered(1) + 1;
+    pendingToken = token;
+
+    // 盤面以值複製給 worker (120 bytes)；隊伍是 implicitly shared 的 QVector，
+    // 複製只加參考計數，engine 之後寫入時才各自分開，UI 怎麼改都不影響計算
+    const QSharedPointer<QAtomicInt> gen = generation;
+    const bool path = dragAssist;
+    watcher.setFuture(QtConcurrent::run([board, party, defender, path, gen, token]() {
+        const DragSolver::Attackers attackers(party, 0, party.size(), defender);
+        return path ? bestPath(board, attackers, gen.data(), token)
+                    : bestSwap(board, attackers, gen.data(), token);
+    }));
+}
+
+void HintEngine::setDragAssist(bool enabled)
+{
+    dragAssist = enabled;
+}
+
+bool HintEngine::isDragAssist() const
+{
+    return dragAssist;
+}
+
+void HintEngine::cancel()
+{
+    generation->fetchAndAddOrdered(1);
+    pendingToken = -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// onFinished(): 只發出最新一次 request() 的結果
+//    setFuture() 換掉舊的 future 時，舊的不會再觸發 finished；
+//    這裡再比對一次 token，擋掉計算完成後才被 cancel() 的結果
+////////////////////////////////////////////////////////////////////////////////
+void HintEngine::onFinished()
+{
+    if (pendingToken < 0 || pendingToken != generation->loadAcquire()) return;
+    pendingToken = -1;
+    emit hintReady(watcher.result());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// bestSwap(): 49 個相鄰交換各自解完 cascade，combo 優先、其次傷害、再其次消除格數
+////////////////////////////////////////////////////////////////////////////////
+HintEngine::Hint HintEngine::bestSwap(const GemBoard &board,
+                                      const DragSolver::Attackers &attackers,
+                                      const QAtomicInt *gen, int token)
+{
+    Hint best = Hint();
+    GemBoard trial = board;
+
+    for (int r = 0; r < GemBoard::ROWS; ++r) {
+        for (int c = 0; c < GemBoard::COLS; ++c) {
+            for (int dir = 0; dir < 2; ++dir) {
+                const int r2 = r + dir;
+                const int c2 = c + 1 - dir;
+                if (r2 >= GemBoard::ROWS || c2 >= GemBoard::COLS) continue;
+
+                if (gen && gen->load() != token) {
+                    return Hint();
+                }
+
+                int combos = 0;
+                int cleared = 0;
+                int damage = 0;
+                trial.swap(r, c, r2, c2);
+                DragSolver::evaluate(trial, attackers, combos, cleared, damage);
+                trial.swap(r, c, r2, c2);
+
+                if (combos > best.comboCount ||
+                    (combos == best.comboCount && damage > best.damage) ||
+                    (combos == best.comboCount && damage == best.damage && cleared > best.clearedCells))
+                {
+                    best.valid = combos > 0;
+                    best.r1 = r;  best.c1 = c;
+                    best.r2 = r2; best.c2 = c2;
+                    best.comboCount = combos;
+                    best.damage = damage;
+                    best.clearedCells = cleared;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// bestPath(): DragSolver 的 beam search；r1/c1 為拿起的格子，r2/c2 為第一步
+////////////////////////////////////////////////////////////////////////////////
+HintEngine::Hint HintEngine::bestPath(const GemBoard &board,
+                                      const DragSolver::Attackers &attackers,
+                                      const QAtomicInt *gen, int token)
+{
+    static const DragSolver solver;
+    const DragSolver::Result r = solver.solve(board, attackers, gen, token);
+    if (gen && gen->load() != token) {
+        return Hint();
+    }
+
+    Hint best = Hint();
+    if (r.comboCount == 0 || r.path.length == 0) return best;
+    best.valid = true;
+    DragSolver::stepCells(r.path, 0, best.r1, best.c1, best.r2, best.c2);
+    best.comboCount = r.comboCount;
+    best.damage = r.damage;
+    best.clearedCells = r.clearedCells;
+    best.path = r.path;
+    return best;
+}
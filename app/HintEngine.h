@@ -0,0 +1,75 @@
+// HintEngine.h
+#pragma once
+
+#include <QObject>
+#include <QAtomicInt>
+#include <QFutureWatcher>
+#include <QSharedPointer>
+#include "Combatants.h"
+#include "DragSolver.h"
+#include "GemBoard.h"
+
+/*
+ * HintEngine
+ *  - 轉珠倒數期間 CPU 幾乎閒置，用 QtConcurrent 在 worker thread 上評估
+ *    目前盤面的全部 49 個相鄰交換 (橫 25 + 直 24)
+ *  - 每個交換都解完 cascade (不補新) 後以 combo、隊伍對本波目標的傷害、消除格數排序，
+ *    最好的一個以 hintReady() 發出
+ *  - 轉珠輔助 (setDragAssist(true)) 時改用 DragSolver 搜尋整條拖動路徑，同樣以傷害排序
+ *  - request() 會讓前一次計算作廢：worker 每評估一個交換就比對一次 generation，
+ *    不一致就立刻結束，結果也不會被發出，所以 UI 拿到的提示一定對應最新的盤面
+ *  - generation 由每個 worker 共同持有：還排在 thread pool 裡的舊計算
+ *    在 HintEngine 解構之後才開始跑也不會讀到已釋放的記憶體
+ */
+class HintEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int SWAP_COUNT = 49;
+
+    struct Hint
+    {
+        bool valid;         // false：沒有能消除的交換
+        int  r1, c1, r2, c2;
+        int  comboCount;    // 含 cascade
+        int  damage;        // Damage::Result::total (同 combo 時的次要排序)
+        int  clearedCells;  // 含 cascade 的消除格數 (同傷害時再比)
+        DragSolver::Path path;  // 轉珠輔助：建議的拖動路徑 (length 為 0 表示單次交換提示)
+    };
+
+    explicit HintEngine(QObject *parent = nullptr);
+    ~HintEngine();
+
+    // 以新盤面、隊伍與目標屬性重新計算 (前一次計算作廢)；party 以值複製給 worker
+    void request(const GemBoard &board, const Combatants &party, int defender);
+
+    // 轉珠輔助：提示整條拖動路徑 (下一次 request() 起生效)
+    void setDragAssist(bool enabled);
+    bool isDragAssist() const;
+
+    // 作廢目前的計算，不發出任何結果
+    void cancel();
+
+    // 同步評估全部交換，回傳最好的一個 (generation 改變時提早結束並回傳 invalid)
+    static Hint bestSwap(const GemBoard &board,
+                         const DragSolver::Attackers &attackers = DragSolver::Attackers(),
+                         const QAtomicInt *generation = nullptr, int token = 0);
+
+    // 以 DragSolver 搜尋拖動路徑 (generation 改變時提早結束並回傳 invalid)
+    static Hint bestPath(const GemBoard &board,
+                         const DragSolver::Attackers &attackers = DragSolver::Attackers(),
+                         const QAtomicInt *generation = nullptr, int token = 0);
+
+signals:
+    void hintReady(const HintEngine::Hint &hint);
+
+private slots:
+    void onFinished();
+
+private:
+    QSharedPointer<QAtomicInt> generation;   // 每次 request() / cancel() 加一
+    int                        pendingToken; // 目前 future 對應的 generation
+    bool                       dragAssist;
+    QFutureWatcher<Hint>       watcher;
+};
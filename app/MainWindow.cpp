@@ -1,5 +1,6 @@
 // MainWindow.cpp
 #include "MainWindow.h"
+#include "StallWatchdog.h"
 #include <QDebug>
 
 MainWindow::MainWindow(QWidget *parent)
@@ -47,14 +48,22 @@ MainWindow::MainWindow(QWidget *parent)
             this, &MainWindow::restartGame);
 
     // (G) GameController → GameStageWidget
+    //     回合開始、轉珠預覽、消除、cascade、傷害走事件佇列，GameStageWidget 每幀取一次
+    gameWidget->setEventChannel(gameController->eventChannel());
     connect(gameController, &GameController::moveTimeUp,
             gameWidget, &GameStageWidget::onMoveTimeUp);
-    connect(gameController, &GameController::matchesFound,
-            gameWidget, &GameStageWidget::onMatchesFound);
-    connect(gameController, &GameController::dealDamage,
-            gameWidget, &GameStageWidget::onDealDamage);
     connect(gameController, &GameController::waveCleared,
             gameWidget, &GameStageWidget::onWaveCleared);
+    connect(gameController, &GameController::hintReady,
+            gameWidget, &GameStageWidget::showHint);
+
+    // 換波：切到背景已排好的那一列敵人、換上新盤面；再下一波的敵人接著在背景排
+    connect(gameController, &GameController::waveCleared, this, [this]() {
+        StallWatchdog::Mark mark("MainWindow waveCleared");
+        gameWidget->showEnemies(gameController->getCurrentWaveEnemies());
+        gameWidget->showBoard(gameController->getBoardMatrix());
+        gameWidget->prefetchEnemies(gameController->getNextWaveEnemies());
+    });
 
     // (H) GameController → MainWindow（直接換到 Finish）
     connect(gameController, &GameController::gameWon, this, [this]() {
@@ -65,12 +74,16 @@ MainWindow::MainWindow(QWidget *parent)
     });
 
     // (I) GameStageWidget → GameController（UI 回報給 Controller）
+    connect(gameWidget, &GameStageWidget::gemsSwapped,
+            gameController, &GameController::swapGems);
     connect(gameWidget, &GameStageWidget::swapFinished,
             gameController, &GameController::onPlayerSwapFinished);
-    connect(gameWidget, &GameStageWidget::clearGems,
-            gameController, &GameController::clearMatchedGems);
+    connect(gameWidget, &GameStageWidget::cascadePlayed,
+            gameController, &GameController::onCascadePlayed);
     connect(gameWidget, &GameStageWidget::enemiesAttacked,
             gameController, &GameController::onEnemiesAttacked);
+    connect(gameWidget, &GameStageWidget::dragAssistToggled,
+            gameController, &GameController::setDragAssist);
 
     // 預設先顯示 Prepare 畫面
     stack->setCurrentIndex(0);
@@ -86,40 +99,18 @@ MainWindow::~MainWindow()
 ////////////////////////////////////////////////////////////////////////////////
 void MainWindow::gotoGameStage(const QVector<int> &selectedChars, int missionID)
 {
+    StallWatchdog::Mark mark("MainWindow::gotoGameStage");
     // 1) 告訴 gameWidget：是哪個 mission & 哪些角色
     gameWidget->setMissionID(missionID);
     gameWidget->setSelectedCharacters(selectedChars);
 
     // 2) 先把遊戲邏輯告訴 Controller
-    QVector<Character*> characterPointers;
-    int totalHP  = 2000;
-    int numChars = 0;
-    // 算一共有幾隻非 0 的角色
-    for (int id : selectedChars) {
-        if (id > 0) ++numChars;
-    }
-    // 把每個 ID 轉成 Character* (此範例只示意屬性為 Water)
-    for (int i = 0; i < selectedChars.size(); ++i) {
-        int id = selectedChars[i];
-        if (id > 0) {
-            Character::Attribute attr = Character::Water;
-            switch (id) {
-                case 1: attr = Character::Water; break;
-                case 2: attr = Character::Fire;  break;
-                case 3: attr = Character::Earth; break;
-                case 4: attr = Character::Light; break;
-                case 5: attr = Character::Dark;  break;
-                case 6: attr = Character::Water; break;
-                default: attr = Character::Water; break;
-            }
-            QString iconPath = QString(":/character/dataset/character/ID%1.png").arg(id);
-            int hpPerChar = (numChars > 0) ? (totalHP / numChars) : totalHP;
-            Character *c = new Character(id, attr, hpPerChar, numChars, iconPath);
-            characterPointers.append(c);
-        }
-    }
+    // 把每個 ID 轉成 Character*
+    const int totalHP = 2000;
+    QVector<Character*> characterPointers = Character::createParty(selectedChars, totalHP);
 
     gameController->init(characterPointers, missionID);
+    gameController->setPartySetup(selectedChars, totalHP);
     gameController->startMission();
 
     // 3) 先 resetGame → 把灰底+空格放上
@@ -131,6 +122,7 @@ void MainWindow::gotoGameStage(const QVector<int> &selectedChars, int missionID)
     // 5) 讓 UI 顯示第一波「敵人圖」＆「符石盤面」
     gameWidget->showEnemies(gameController->getCurrentWaveEnemies());
     gameWidget->showBoard(gameController->getBoardMatrix());
+    gameWidget->prefetchEnemies(gameController->getNextWaveEnemies());
 
     // 6) 切到 Game 畫面
     stack->setCurrentIndex(1);
@@ -177,6 +169,7 @@ void MainWindow::surrenderFromPause()
 ////////////////////////////////////////////////////////////////////////////////
 void MainWindow::restartGame()
 {
+    StallWatchdog::Mark mark("MainWindow::restartGame");
     gameWidget->resetGame();
     stack->setCurrentIndex(0);
 }
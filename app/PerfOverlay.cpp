@@ -0,0 +1,150 @@
+// PerfOverlay.cpp
+#include "PerfOverlay.h"
+#include "FrameClock.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFontDatabase>
+#include <QPainter>
+#include <QStandardPaths>
+
+namespace {
+
+const int ROW_HEIGHT = 16;
+const int WIDTH      = 330;
+const qint64 FRAME_BUDGET_NS = FrameClock::DEFAULT_INTERVAL_MS * 1000000LL;
+
+QString ms(qint64 ns)
+{
+    return QString::number(ns / 1.0e6, 'f', 3).rightJustified(8);
+}
+
+} // namespace
+
+PerfOverlay::PerfOverlay(QWidget *parent)
+    : QWidget(parent),
+      refreshTimer(new QTimer(this)),
+      probeTimer(new QTimer(this)),
+      lastProbeNs(0)
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    setFixedSize(WIDTH, ROW_HEIGHT * (PerfStats::METRIC_COUNT + PerfStats::COUNTER_COUNT + 3) + 8);
+
+    refreshTimer->setInterval(REFRESH_MS);
+    connect(refreshTimer, &QTimer::timeout, this, [this]() { update(); });
+
+    probeTimer->setTimerType(Qt::PreciseTimer);
+    probeTimer->setInterval(PROBE_MS);
+    connect(probeTimer, &QTimer::timeout, this, &PerfOverlay::onProbe);
+
+    hide();
+}
+
+void PerfOverlay::toggle()
+{
+    setVisible(!isVisible());
+    if (isVisible()) raise();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// showEvent() / hideEvent(): 量測只在 HUD 顯示時進行
+////////////////////////////////////////////////////////////////////////////////
+void PerfOverlay::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    PerfStats &stats = PerfStats::instance();
+    stats.clear();
+    stats.setEnabled(true);
+    lastProbeNs = stats.now();
+    probeTimer->start();
+    refreshTimer->start();
+}
+
+void PerfOverlay::hideEvent(QHideEvent *event)
+{
+    QWidget::hideEvent(event);
+    PerfStats::instance().setEnabled(false);
+    probeTimer->stop();
+    refreshTimer->stop();
+}
+
+void PerfOverlay::onProbe()
+{
+    PerfStats &stats = PerfStats::instance();
+    const qint64 now = stats.now();
+    stats.record(PerfStats::EventLatency, qMax<qint64>(0, now - lastProbeNs - PROBE_MS * 1000000LL));
+    lastProbeNs = now;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// dumpCsv(): 一鍵存下目前視窗內的所有樣本
+////////////////////////////////////////////////////////////////////////////////
+QString PerfOverlay::dumpCsv()
+{
+    const QString dirPath = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)
+                            + "/perf";
+    const QString fileName = QString("%1/perf-%2.csv")
+                                 .arg(dirPath)
+                                 .arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss"));
+
+    if (!QDir().mkpath(dirPath) || !PerfStats::instance().writeCsv(fileName)) {
+        qWarning() << "[PerfOverlay] cannot write" << fileName;
+        statusLine = tr("CSV write failed");
+        update();
+        return QString();
+    }
+
+    qDebug() << "[PerfOverlay] perf stats saved:" << fileName;
+    statusLine = fileName;
+    update();
+    return fileName;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// paintEvent(): 一列一個量測項目，單位 ms
+////////////////////////////////////////////////////////////////////////////////
+void PerfOverlay::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(0, 0, 0, 180));
+    painter.setPen(Qt::white);
+
+    int y = 4;
+    auto row = [&](const QString &text) {
+        painter.drawText(QRect(6, y, width() - 12, ROW_HEIGHT), Qt::AlignVCenter | Qt::AlignLeft, text);
+        y += ROW_HEIGHT;
+    };
+
+    row(QString("%1%2%3%4%5")
+            .arg(QString("ms  (F3/F4)"), -14)
+            .arg("last", 8).arg("p50", 8).arg("p99", 8).arg("max", 8));
+
+    const PerfStats &stats = PerfStats::instance();
+    for (int m = 0; m < PerfStats::METRIC_COUNT; ++m) {
+        const PerfStats::Summary s = stats.summary(PerfStats::Metric(m));
+        const QString name = QString(PerfStats::metricName(PerfStats::Metric(m))).leftJustified(14);
+        if (s.count == 0) {
+            row(name + QString("-").rightJustified(8));
+            continue;
+        }
+        // p99 超過一幀的預算 (幀間隔本身為兩幀) 就標紅，一眼看出是哪一段卡住
+        const qint64 budget = m == PerfStats::FrameTime ? 2 * FRAME_BUDGET_NS : FRAME_BUDGET_NS;
+        painter.setPen(s.p99 > budget ? QColor(255, 96, 96) : QColor(Qt::white));
+        row(name + ms(s.last) + ms(s.p50) + ms(s.p99) + ms(s.max));
+        painter.setPen(Qt::white);
+    }
+
+    // 累計計數：非 0 就標紅 (例如暖機後還在配置 widget)
+    for (int c = 0; c < PerfStats::COUNTER_COUNT; ++c) {
+        const quint64 value = stats.counter(PerfStats::Counter(c));
+        painter.setPen(value > 0 ? QColor(255, 96, 96) : QColor(Qt::white));
+        row(QString(PerfStats::counterName(PerfStats::Counter(c))).leftJustified(14)
+            + QString::number(value).rightJustified(8));
+        painter.setPen(Qt::white);
+    }
+
+    if (!statusLine.isEmpty()) {
+        row(painter.fontMetrics().elidedText(statusLine, Qt::ElideLeft, width() - 12));
+    }
+}
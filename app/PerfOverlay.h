@@ -0,0 +1,45 @@
+// PerfOverlay.h
+#pragma once
+
+#include <QWidget>
+#include <QTimer>
+#include "PerfStats.h"
+
+/*
+ * PerfOverlay
+ *  - 疊在 GameStageWidget 右上角的效能 HUD：幀時間、繪製時間、事件迴圈延遲、
+ *    controller 與 engine 各階段、widget 重建、pixmap 縮放的 last / p50 / p99 / max
+ *  - 顯示時才開啟 PerfStats 與事件迴圈延遲探針；隱藏時完全不量測
+ *  - 每 250 ms 重畫一次，不向 FrameClock 要幀 (HUD 本身不影響幀時間)
+ *  - 不接收滑鼠事件，不擋轉珠
+ */
+class PerfOverlay : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit PerfOverlay(QWidget *parent = nullptr);
+
+    // 顯示／隱藏，並開關量測
+    void toggle();
+
+    // 寫到 <AppLocalData>/perf/perf-<時間>.csv；回傳檔名 (失敗時為空字串)
+    QString dumpCsv();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private slots:
+    void onProbe();
+
+private:
+    static constexpr int REFRESH_MS = 250;
+    static constexpr int PROBE_MS   = 50;
+
+    QTimer  *refreshTimer;
+    QTimer  *probeTimer;        // 事件迴圈延遲：實際觸發時間 - 預期時間
+    qint64   lastProbeNs;
+    QString  statusLine;        // 最近一次 CSV 的結果
+};
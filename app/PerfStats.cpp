@@ -0,0 +1,182 @@
+// PerfStats.cpp
+#include "PerfStats.h"
+#include <QFile>
+#include <QTextStream>
+#include <cstring>
+
+static_assert(PerfStats::WINDOW <= 0xffff, "histogram counts are 16-bit");
+
+PerfStats::PerfStats()
+    : enabled(false)
+{
+    clock.start();
+    clear();
+    std::memset(counters, 0, sizeof(counters));
+}
+
+PerfStats &PerfStats::instance()
+{
+    static PerfStats stats;
+    return stats;
+}
+
+const char *PerfStats::metricName(Metric metric)
+{
+    switch (metric) {
+        case FrameTime:     return "frame";
+        case PaintTime:     return "paint";
+        case EventLatency:  return "event-loop";
+        case Controller:    return "controller";
+        case Match:         return "match";
+        case Gravity:       return "gravity";
+        case Refill:        return "refill";
+        case EnemyPhase:    return "enemy";
+        case WidgetRebuild: return "widget-rebuild";
+        case PixmapScale:   return "pixmap-scale";
+        case METRIC_COUNT:  break;
+    }
+    return "?";
+}
+
+const char *PerfStats::counterName(Counter counter)
+{
+    switch (counter) {
+        case WidgetAllocations: return "widget-allocs";
+        case COUNTER_COUNT:     break;
+    }
+    return "?";
+}
+
+void PerfStats::setEnabled(bool on)
+{
+    enabled = on;
+}
+
+qint64 PerfStats::now() const
+{
+    return clock.nsecsElapsed();
+}
+
+void PerfStats::clear()
+{
+    std::memset(series, 0, sizeof(series));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// bucketOf() / bucketValue(): 對數分桶
+//    v < 2*SUB 各自一桶；之後每個 2 的次方 [2^e, 2^(e+1)) 平均切成 SUB 桶
+////////////////////////////////////////////////////////////////////////////////
+int PerfStats::bucketOf(quint32 value)
+{
+    if (value < quint32(2 * SUB)) return int(value);
+
+    int e = 31;
+    while (!(value >> e)) --e;                      // e >= 4
+    const int sub = int(value >> (e - 3)) & (SUB - 1);
+    return 2 * SUB + (e - 4) * SUB + sub;
+}
+
+qint64 PerfStats::bucketValue(int bucket)
+{
+    if (bucket < 2 * SUB) return bucket;
+
+    const int e = (bucket - 2 * SUB) / SUB + 4;
+    const int sub = (bucket - 2 * SUB) % SUB;
+    const qint64 width = qint64(1) << (e - 3);
+    return (qint64(SUB + sub) << (e - 3)) + width / 2;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// record(): 新樣本寫進 ring，直方圖同步加入新值、扣掉被擠掉的舊值
+////////////////////////////////////////////////////////////////////////////////
+void PerfStats::record(Metric metric, qint64 nanoseconds)
+{
+    Series &s = series[metric];
+    const quint32 value = quint32(qBound<qint64>(0, nanoseconds, 0xffffffffLL));
+
+    if (s.count == WINDOW) {
+        --s.histogram[bucketOf(s.samples[s.next])];
+    } else {
+        ++s.count;
+    }
+    s.samples[s.next] = value;
+    ++s.histogram[bucketOf(value)];
+    s.next = (s.next + 1) % WINDOW;
+}
+
+qint64 PerfStats::percentile(const Series &s, int percent) const
+{
+    // 第 ceil(count * percent / 100) 小的樣本所在的桶
+    const int rank = qMax(1, (s.count * percent + 99) / 100);
+    int seen = 0;
+    for (int b = 0; b < BUCKETS; ++b) {
+        seen += s.histogram[b];
+        if (seen >= rank) return bucketValue(b);
+    }
+    return 0;
+}
+
+PerfStats::Summary PerfStats::summary(Metric metric) const
+{
+    const Series &s = series[metric];
+    Summary out = Summary();
+    out.count = s.count;
+    if (s.count == 0) return out;
+
+    out.last = s.samples[(s.next + WINDOW - 1) % WINDOW];
+    for (int i = 0; i < s.count; ++i) {
+        out.max = qMax<qint64>(out.max, s.samples[i]);
+    }
+    // 分桶取中間值，不讓它超過實際最大值
+    out.p50 = qMin(percentile(s, 50), out.max);
+    out.p99 = qMin(percentile(s, 99), out.max);
+    return out;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// writeCsv(): kind,metric,index,ns
+//    先是每項的 p50 / p99 / max，接著是視窗內的樣本 (index 0 = 最舊)
+////////////////////////////////////////////////////////////////////////////////
+bool PerfStats::writeCsv(const QString &path) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << "kind,metric,index,ns\n";
+    for (int m = 0; m < METRIC_COUNT; ++m) {
+        const Summary sum = summary(Metric(m));
+        const char *name = metricName(Metric(m));
+        out << "p50," << name << ",," << sum.p50 << '\n';
+        out << "p99," << name << ",," << sum.p99 << '\n';
+        out << "max," << name << ",," << sum.max << '\n';
+    }
+    for (int m = 0; m < METRIC_COUNT; ++m) {
+        const Series &s = series[m];
+        const int first = s.count == WINDOW ? s.next : 0;
+        for (int i = 0; i < s.count; ++i) {
+            out << "sample," << metricName(Metric(m)) << ',' << i << ','
+                << s.samples[(first + i) % WINDOW] << '\n';
+        }
+    }
+    out.flush();
+    return file.error() == QFileDevice::NoError;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Scope
+////////////////////////////////////////////////////////////////////////////////
+PerfStats::Scope::Scope(Metric m)
+    : metric(m),
+      start(PerfStats::instance().isEnabled() ? PerfStats::instance().now() : -1)
+{
+}
+
+PerfStats::Scope::~Scope()
+{
+    if (start < 0) return;
+    PerfStats &stats = PerfStats::instance();
+    stats.record(metric, stats.now() - start);
+}
@@ -0,0 +1,104 @@
+// PerfStats.h
+#pragma once
+
+#include <QElapsedTimer>
+#include <QString>
+
+/*
+ * PerfStats
+ *  - 效能 HUD 的資料來源：每個量測項目保留最近 WINDOW 筆 (奈秒) 的 ring buffer，
+ *    並同步維護一份對數分桶的直方圖 (新樣本 +1、被擠掉的樣本 -1)
+ *  - p50 / p99 直接掃直方圖，不排序、不配置；分桶誤差在 1/8 以內
+ *  - 預設關閉 (Scope 只多一次 bool 判斷)；HUD 顯示時才開啟
+ *  - 只在 GUI thread 使用
+ */
+class PerfStats
+{
+public:
+    enum Metric {
+        FrameTime = 0,      // FrameClock 相鄰兩幀的間隔
+        PaintTime,          // BoardWidget::paintEvent
+        EventLatency,       // 事件迴圈延遲 (計時器實際觸發 - 預期時間)
+        Controller,         // GameController::advanceEngine 整段
+        Match,              // GameEngine：連線判定
+        Gravity,            //             下落
+        Refill,             //             補新
+        EnemyPhase,         //             敵人回合
+        WidgetRebuild,      // GameStageWidget 重建敵人／角色 label
+        PixmapScale,        // SpriteCache 解碼 + 縮放
+        METRIC_COUNT
+    };
+
+    // 累計計數 (不受 setEnabled() 影響、clear() 也不歸零)
+    enum Counter {
+        WidgetAllocations = 0,  // 暖機 (畫面建好) 之後才配置的 widget；正常應該一直是 0
+        COUNTER_COUNT
+    };
+
+    static constexpr int WINDOW  = 256;     // 每項保留的樣本數
+    static constexpr int SUB     = 8;       // 每個 2 的次方切成幾桶
+    static constexpr int BUCKETS = 2 * SUB + (32 - 4) * SUB;
+
+    struct Summary
+    {
+        int    count;       // 視窗內的樣本數
+        qint64 last;        // 以下皆為奈秒
+        qint64 p50;
+        qint64 p99;
+        qint64 max;
+    };
+
+    // 量測一段程式：建構時記下時間，解構時寫入 (未開啟時不讀時鐘)
+    class Scope
+    {
+    public:
+        explicit Scope(Metric metric);
+        ~Scope();
+
+    private:
+        Q_DISABLE_COPY(Scope)
+        Metric metric;
+        qint64 start;
+    };
+
+    static PerfStats &instance();
+    static const char *metricName(Metric metric);
+    static const char *counterName(Counter counter);
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled; }
+
+    // 單調時鐘 (奈秒)
+    qint64 now() const;
+
+    void    record(Metric metric, qint64 nanoseconds);
+    Summary summary(Metric metric) const;
+    void    clear();
+
+    void    count(Counter counter, int n = 1) { counters[counter] += quint64(n); }
+    quint64 counter(Counter counter) const    { return counters[counter]; }
+
+    // 每項的 p50/p99 與視窗內全部樣本 (由舊到新) 寫成 CSV
+    bool writeCsv(const QString &path) const;
+
+private:
+    PerfStats();
+    Q_DISABLE_COPY(PerfStats)
+
+    struct Series
+    {
+        quint32 samples[WINDOW];
+        int     next;               // 下一筆寫入的位置
+        int     count;
+        quint16 histogram[BUCKETS];
+    };
+
+    static int    bucketOf(quint32 value);
+    static qint64 bucketValue(int bucket);     // 該桶的中間值
+    qint64        percentile(const Series &s, int percent) const;
+
+    Series        series[METRIC_COUNT];
+    quint64       counters[COUNTER_COUNT];
+    QElapsedTimer clock;
+    bool          enabled;
+};
@@ -1,11 +1,17 @@
 #include "PrepareStageWidget.h"
+#include "AssetPreloader.h"
+#include "Character.h"
+#include "SpriteCache.h"
+#include "MissionTable.h"
 #include <QMessageBox>
 #include <QIcon>
 #include <QSize>
 #include <QFont>
 
 PrepareStageWidget::PrepareStageWidget(QWidget *parent)
-    : QWidget(parent)
+    : QWidget(parent),
+      waitingForAssets(false),
+      pendingMission(0)
 {
     // MainWindow 會替本 Widget 設定固定大小 540×960，所以這裡不需再呼叫 setFixedSize
 
@@ -24,7 +30,7 @@ PrepareStageWidget::PrepareStageWidget(QWidget *parent)
     //----------------------------------------
     // (2) 六個 QComboBox 並排，用於選角色
     //    - 第一項為空（表示此槽位不選人物，回傳 0）
-    //    - 後面 1~5 為角色 ID，同時配合 Icon 圖示顯示
+    //    - 後面 1~5 為角色 ID，圖示在 AssetPreloader 解好後才貼上 (onAssetReady)
     QHBoxLayout *hLayoutChars = new QHBoxLayout;
     hLayoutChars->setSpacing(8);
 
@@ -32,17 +38,15 @@ PrepareStageWidget::PrepareStageWidget(QWidget *parent)
     for (int i = 0; i < 6; ++i) {
         comboChars[i] = new QComboBox(this);
         comboChars[i]->setFixedSize(70, 70);
-        comboChars[i]->setIconSize(QSize(48, 48));
+        comboChars[i]->setIconSize(QSize(AssetPreloader::PREPARE_ICON_SIZE,
+                                         AssetPreloader::PREPARE_ICON_SIZE));
 
         // 第一個選項是空白 (代表此槽不選角色)
         comboChars[i]->addItem("");
 
-        // 後面 1~5 為角色 ID，同時顯示圖示
-        for (int id = 1; id <= 5; ++id) {
-            QString text = QString::number(id);
-            // 注意：請把下面這條路徑改成你真正放置角色圖示的 qrc 路徑
-            QString iconPath = QString(":/character/dataset/character/ID%1.png").arg(id);
-            comboChars[i]->addItem(QIcon(iconPath), text);
+        // 後面 1~5 為角色 ID
+        for (int id = 1; id <= Character::ROSTER_SIZE; ++id) {
+            comboChars[i]->addItem(QString::number(id));
         }
 
         comboChars[i]->setCurrentIndex(0); // 預設空白
@@ -65,7 +69,7 @@ PrepareStageWidget::PrepareStageWidget(QWidget *parent)
     //----------------------------------------
     // (5) QSpinBox 作為 mission 輸入，可以用鍵盤直接輸入數字
     spinMission = new QSpinBox(this);
-    spinMission->setRange(1, 10);  // 範例只給 1~10
+    spinMission->setRange(1, qMax(1, MissionTable::shared().maxMissionID()));  // 依 mission 定義檔
     spinMission->setValue(1);      // 預設為 1
     spinMission->setFixedSize(100, 40);
     spinMission->setKeyboardTracking(false);
@@ -88,6 +92,47 @@ PrepareStageWidget::PrepareStageWidget(QWidget *parent)
     mainLayout->addWidget(startButton, 0, Qt::AlignHCenter);
 
     mainLayout->addSpacing(20);
+
+    //----------------------------------------
+    // (8) 已經解好的角色圖示先貼上，其餘等 AssetPreloader 通知
+    AssetPreloader &preloader = AssetPreloader::instance();
+    connect(&preloader, &AssetPreloader::assetReady, this, &PrepareStageWidget::onAssetReady);
+    connect(&preloader, &AssetPreloader::finished, this, &PrepareStageWidget::tryStart);
+    for (int id = 1; id <= Character::ROSTER_SIZE; ++id) {
+        const QString iconPath = Character::iconPathFor(id);
+        if (preloader.isReady(iconPath)) onAssetReady(iconPath);
+    }
+}
+
+void PrepareStageWidget::onAssetReady(const QString &asset)
+{
+    for (int id = 1; id <= Character::ROSTER_SIZE; ++id) {
+        const QString iconPath = Character::iconPathFor(id);
+        if (asset != iconPath) continue;
+
+        const int size = AssetPreloader::PREPARE_ICON_SIZE;
+        const QIcon icon(SpriteCache::instance().pixmap(iconPath, QSize(size, size),
+                                                        devicePixelRatioF()));
+        for (int i = 0; i < 6; ++i) {
+            comboChars[i]->setItemIcon(id, icon);
+        }
+        break;
+    }
+
+    if (waitingForAssets) tryStart();
+}
+
+void PrepareStageWidget::tryStart()
+{
+    if (!waitingForAssets) return;
+
+    const QStringList required = AssetPreloader::missionAssets(pendingMission, pendingChars);
+    if (!AssetPreloader::instance().isReady(required)) return;
+
+    waitingForAssets = false;
+    startButton->setEnabled(true);
+    startButton->setText("Start");
+    emit startClicked(pendingChars, pendingMission);
 }
 
 void PrepareStageWidget::onStartButtonClicked()
@@ -126,5 +171,13 @@ void PrepareStageWidget::onStartButtonClicked()
     int missionID = spinMission->value();
 
     // (5) 發射信號：帶出長度 6、空位以 0 表示的 selectedChars
-    emit startClicked(padded, missionID);
+    //     這個 mission 需要的圖還沒解好就先等 (其他 mission 的圖不影響)
+    waitingForAssets = true;
+    pendingChars = padded;
+    pendingMission = missionID;
+    if (!AssetPreloader::instance().isReady(AssetPreloader::missionAssets(missionID, padded))) {
+        startButton->setEnabled(false);
+        startButton->setText("Loading…");
+    }
+    tryStart();
 }
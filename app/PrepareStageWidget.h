@@ -18,6 +18,8 @@
  *  - 其下：Game Mission: (文字標題)
  *  - 一個 QSpinBox (允許鍵盤輸入整數，範例只給 1 可選)
  *  - 最下方：Start 按鈕 (按下後核對至少有一個角色被選，再把參數發出)
+ *  - 圖檔由 AssetPreloader 在背景解碼：角色圖示解好才貼上，畫面一開始就能操作；
+ *    按下 Start 時若這個 mission 需要的圖還沒好，按鈕顯示 Loading… 等到好了才發出
  *
  * Signal:
  *  void startClicked(const QVector<int> &selectedChars, int missionID);
@@ -39,6 +41,12 @@ private slots:
     // Start 按鈕被點
     void onStartButtonClicked();
 
+    // AssetPreloader 每解好一張圖
+    void onAssetReady(const QString &asset);
+
+    // 需要的圖都好了就發出 startClicked (否則繼續等)
+    void tryStart();
+
 private:
     // 六個下拉式選單：每個 index 0 = 空白，1~5 = 角色 ID
     QComboBox *comboChars[6];
@@ -48,4 +56,9 @@ private:
 
     // Start 按鈕
     QPushButton *startButton;
+
+    // 按下 Start 後等圖檔的參數
+    bool         waitingForAssets;
+    QVector<int> pendingChars;
+    int          pendingMission;
 };
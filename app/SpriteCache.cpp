@@ -0,0 +1,148 @@
+// SpriteCache.cpp
+#include "SpriteCache.h"
+#include "GemSprite.h"
+#include "PerfStats.h"
+#include <QDebug>
+
+////////////////////////////////////////////////////////////////////////////////
+// Key
+////////////////////////////////////////////////////////////////////////////////
+
+bool SpriteCache::Key::operator==(const Key &other) const
+{
+    return variant == other.variant &&
+           size == other.size &&
+           qFuzzyCompare(dpr, other.dpr) &&
+           asset == other.asset;
+}
+
+uint qHash(const SpriteCache::Key &key, uint seed)
+{
+    seed = qHash(key.asset, seed);
+    seed = qHash(key.size.width(), seed) ^ (qHash(key.size.height(), seed) << 1);
+    seed ^= qHash(qRound(key.dpr * 100), seed) + key.variant;
+    return seed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor / instance
+////////////////////////////////////////////////////////////////////////////////
+
+SpriteCache::SpriteCache()
+{
+    counters = Stats();
+}
+
+SpriteCache &SpriteCache::instance()
+{
+    static SpriteCache cache;
+    return cache;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// decoded(): 第一次用到某張圖時才解碼，之後直接回傳
+////////////////////////////////////////////////////////////////////////////////
+
+const QImage &SpriteCache::decoded(const QString &asset)
+{
+    auto it = decodedImages.find(asset);
+    if (it == decodedImages.end()) {
+        const QImage img = decode(asset);
+        ++counters.decodes;
+        counters.bytes += img.sizeInBytes();
+        it = decodedImages.insert(asset, img);
+    }
+    return it.value();
+}
+
+QImage SpriteCache::decode(const QString &asset)
+{
+    QImage img(asset);
+    if (img.isNull()) {
+        qWarning() << "[SpriteCache] failed to load" << asset;
+        return img;
+    }
+    return img.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+}
+
+QImage SpriteCache::scale(const QImage &src, const QSize &size, qreal dpr)
+{
+    return src.scaled(size * dpr, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// pixmap(): 命中就直接回傳；否則縮放一次並保存
+////////////////////////////////////////////////////////////////////////////////
+
+QPixmap SpriteCache::pixmap(const QString &asset, const QSize &size,
+                            qreal dpr, int variant)
+{
+    const Key key = { asset, size, dpr, variant };
+
+    auto it = scaledPixmaps.constFind(key);
+    if (it != scaledPixmaps.constEnd()) {
+        ++counters.hits;
+        return it.value();
+    }
+
+    ++counters.misses;
+    PerfStats::Scope scope(PerfStats::PixmapScale);
+    const QImage &src = decoded(asset);
+
+    QPixmap pix;
+    if (!src.isNull()) {
+        const QImage scaled = scale(src, size, dpr);
+        pix = QPixmap::fromImage(scaled);
+        pix.setDevicePixelRatio(dpr);
+        counters.bytes += scaled.sizeInBytes();
+    }
+    scaledPixmaps.insert(key, pix);
+    return pix;
+}
+
+QPixmap SpriteCache::gemPixmap(Gem::Attribute type, Gem::EffectStatus effect,
+                               const QSize &size, qreal dpr)
+{
+    return pixmap(GemSprite::iconPathFor(type, effect), size, dpr, effect);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// adoptDecoded() / adoptScaled(): AssetPreloader 交回 worker 的結果
+//    UI thread 已經自己解過 (使用者比預載快) 的就保留原本的
+////////////////////////////////////////////////////////////////////////////////
+
+void SpriteCache::adoptDecoded(const QString &asset, const QImage &image)
+{
+    if (decodedImages.contains(asset)) return;
+    ++counters.decodes;
+    counters.bytes += image.sizeInBytes();
+    decodedImages.insert(asset, image);
+}
+
+void SpriteCache::adoptScaled(const QString &asset, const QSize &size, qreal dpr, int variant,
+                              const QImage &scaled)
+{
+    const Key key = { asset, size, dpr, variant };
+    if (scaled.isNull() || scaledPixmaps.contains(key)) return;
+
+    QPixmap pix = QPixmap::fromImage(scaled);
+    pix.setDevicePixelRatio(dpr);
+    counters.bytes += scaled.sizeInBytes();
+    scaledPixmaps.insert(key, pix);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 統計與清除
+////////////////////////////////////////////////////////////////////////////////
+
+SpriteCache::Stats SpriteCache::stats() const
+{
+    return counters;
+}
+
+void SpriteCache::clear()
+{
+    decodedImages.clear();
+    scaledPixmaps.clear();
+    counters.bytes = 0;
+}
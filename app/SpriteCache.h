@@ -0,0 +1,72 @@
+// SpriteCache.h
+#pragma once
+
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QSize>
+#include <QString>
+#include "Gem.h"
+
+/*
+ * SpriteCache
+ *  - data.qrc 裡每張 PNG 只解碼一次 (轉成 premultiplied ARGB 的 QImage)
+ *  - 以 (圖檔, 目標尺寸, device pixel ratio, 效果變體) 為 key 保存縮放好的 QPixmap
+ *  - 回傳的 QPixmap 是 implicit sharing，取用只是一次指標複製
+ *  - 只能在 UI thread 使用 (QPixmap 的限制)；decode() / scale() 是純函式，
+ *    AssetPreloader 在 worker thread 上先做好，再以 adopt*() 交回
+ */
+class SpriteCache
+{
+public:
+    struct Stats
+    {
+        quint64 hits;       // 直接命中縮放好的 pixmap
+        quint64 misses;     // 需要縮放一次
+        quint64 decodes;    // 實際解碼 PNG 的次數
+        qint64  bytes;      // 目前保存的圖資大小 (解碼圖 + 縮放圖)
+    };
+
+    static SpriteCache &instance();
+
+    // 取得縮放到 size (邏輯像素、保持比例) 的圖；variant 用來區分同一張圖的不同效果
+    QPixmap pixmap(const QString &asset, const QSize &size,
+                   qreal dpr = 1.0, int variant = 0);
+
+    // 符石專用：依屬性、效果找對應圖檔
+    QPixmap gemPixmap(Gem::Attribute type, Gem::EffectStatus effect,
+                      const QSize &size, qreal dpr = 1.0);
+
+    // 解碼並轉成 premultiplied ARGB / 縮放到 size × dpr (任何 thread 都可呼叫)
+    static QImage decode(const QString &asset);
+    static QImage scale(const QImage &src, const QSize &size, qreal dpr);
+
+    // 收下別的 thread 做好的結果 (已經有的不覆蓋)；QPixmap 轉換只在這裡做一次
+    void adoptDecoded(const QString &asset, const QImage &image);
+    void adoptScaled(const QString &asset, const QSize &size, qreal dpr, int variant,
+                     const QImage &scaled);
+
+    Stats stats() const;
+    void  clear();
+
+private:
+    SpriteCache();
+    Q_DISABLE_COPY(SpriteCache)
+
+    struct Key
+    {
+        QString asset;
+        QSize   size;
+        qreal   dpr;
+        int     variant;
+
+        bool operator==(const Key &other) const;
+    };
+    friend uint qHash(const Key &key, uint seed);
+
+    const QImage &decoded(const QString &asset);
+
+    QHash<QString, QImage> decodedImages;   // 原始尺寸的解碼結果
+    QHash<Key, QPixmap>    scaledPixmaps;   // 縮放後的結果
+    Stats                  counters;
+};
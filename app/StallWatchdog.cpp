@@ -0,0 +1,290 @@
+// StallWatchdog.cpp
+#include "StallWatchdog.h"
+#include <QAbstractEventDispatcher>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QEvent>
+#include <QFile>
+#include <QFileInfo>
+#include <QMetaEnum>
+#include <QStandardPaths>
+#include <QTextStream>
+
+QAtomicPointer<const char> StallWatchdog::marks[StallWatchdog::MAX_MARKS];
+QAtomicInt                 StallWatchdog::markDepth(0);
+StallWatchdog             *StallWatchdog::active = nullptr;
+
+StallWatchdog::StallWatchdog(int budgetMs, const QString &logPath, QObject *parent)
+    : QThread(parent),
+      budget(qMax(1, budgetMs)),
+      path(logPath),
+      dispatchDepth(0),
+      loopDepth(0),
+      dispatchSeq(0),
+      busySinceNs(-1),
+      receiverClass(nullptr),
+      eventType(0),
+      probeHandledNs(0),
+      stopping(0)
+{
+    setObjectName("StallWatchdog");
+    clock.start();
+
+    // 事件迴圈準備睡著 → 閒；巢狀的 exec() 睡著時，之後在那一層派送的事件當作最外層
+    QAbstractEventDispatcher *dispatcher = QAbstractEventDispatcher::instance(QThread::currentThread());
+    if (dispatcher) {
+        connect(dispatcher, &QAbstractEventDispatcher::aboutToBlock, this, [this]() {
+            loopDepth = dispatchDepth;
+            markIdle();
+        }, Qt::DirectConnection);
+    }
+    active = this;
+}
+
+StallWatchdog::~StallWatchdog()
+{
+    if (active == this) active = nullptr;
+    stopping.storeRelease(1);
+    wait();
+}
+
+int StallWatchdog::budgetMs() const
+{
+    return budget;
+}
+
+QString StallWatchdog::logPath() const
+{
+    return path;
+}
+
+int StallWatchdog::configuredBudgetMs()
+{
+    bool ok = false;
+    const int ms = qEnvironmentVariableIntValue("TOS_STALL_BUDGET_MS", &ok);
+    return ok ? qMax(0, ms) : DEFAULT_BUDGET_MS;
+}
+
+QString StallWatchdog::defaultLogPath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/stalls.log";
+}
+
+QEvent::Type StallWatchdog::probeEventType()
+{
+    static const QEvent::Type type = QEvent::Type(QEvent::registerEventType());
+    return type;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// GUI thread 這一側：只有 atomic 寫入，不配置、不上鎖
+////////////////////////////////////////////////////////////////////////////////
+StallWatchdog::Dispatch::Dispatch(QObject *receiver, QEvent *event)
+    : watchdog(active)
+{
+    if (!watchdog) return;
+    if (watchdog->dispatchDepth == watchdog->loopDepth) {
+        watchdog->markBusy(receiver->metaObject()->className(), event->type());
+    }
+    ++watchdog->dispatchDepth;
+}
+
+StallWatchdog::Dispatch::~Dispatch()
+{
+    if (!watchdog) return;
+    if (--watchdog->dispatchDepth <= watchdog->loopDepth) {
+        // 回到事件迴圈 (巢狀的 exec() 結束後也回到外面那一層)
+        watchdog->loopDepth = watchdog->dispatchDepth;
+        watchdog->markIdle();
+    }
+}
+
+bool StallWatchdog::event(QEvent *event)
+{
+    if (event->type() == probeEventType()) {
+        probeHandledNs.store(clock.nsecsElapsed(), std::memory_order_release);
+        return true;
+    }
+    return QThread::event(event);
+}
+
+void StallWatchdog::markBusy(const char *receiver, int type)
+{
+    receiverClass.store(receiver);
+    eventType.store(type);
+    busySinceNs.store(clock.nsecsElapsed(), std::memory_order_relaxed);
+    dispatchSeq.fetchAndAddRelease(1);
+}
+
+void StallWatchdog::markIdle()
+{
+    busySinceNs.store(-1, std::memory_order_relaxed);
+    dispatchSeq.fetchAndAddRelease(1);
+}
+
+// watchdog thread：排一個 probe 到 GUI thread 的事件佇列尾端
+void StallWatchdog::postProbe()
+{
+    probeHandledNs.store(-1, std::memory_order_relaxed);
+    QCoreApplication::postEvent(this, new QEvent(probeEventType()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// run(): watchdog thread，每 budget/4 取樣一次
+//    (1) 同一個最外層事件 (dispatchSeq 不變) 持續超過 budget → 記下開始時間與看到的最深
+//        Mark 堆疊，seq 改變 (事件結束) 時寫出整段長度 (誤差在一個取樣間隔內)
+//    (2) heartbeat：probe 處理完時，等待時間超過 budget 且這段期間 (1) 沒有報過 → 記一筆 latency
+////////////////////////////////////////////////////////////////////////////////
+void StallWatchdog::run()
+{
+    const qint64 budgetNs = qint64(budget) * 1000000;
+    const qint64 hangNs = qint64(HANG_MS) * 1000000;
+    const unsigned long periodMs = qMax(1, budget / 4);
+    const QMetaEnum eventNames = QMetaEnum::fromType<QEvent::Type>();
+
+    quint32 seenSeq = dispatchSeq.loadAcquire();
+    bool stalled = false;
+    bool hangReported = false;
+    qint64 stallStart = 0;
+    qint64 lastSample = 0;
+    const char *receiver = nullptr;
+    int type = QEvent::None;
+    const char *stack[MAX_MARKS];
+    int stackDepth = 0;
+
+    qint64 probePosted = -1;            // -1：沒有等待中的 probe
+    quint32 probeSeq = 0;
+    bool probeCovered = false;          // 等待期間 (1) 已經報過
+    bool probeHangReported = false;
+    const char *lastReceiver = nullptr; // 等待期間最後看到的最外層事件
+    int lastType = QEvent::None;
+
+    auto target = [&](const char *cls, int t) {
+        const char *typeName = eventNames.valueToKey(t);
+        return QString("[%1 %2]")
+                   .arg(cls ? QString::fromLatin1(cls) : QString("event loop"))
+                   .arg(typeName ? QString::fromLatin1(typeName) : QString::number(t));
+    };
+
+    auto describe = [&](qint64 durationNs, bool finished) {
+        QString line = QString("%1 stall %2 ms (budget %3 ms)%4")
+                           .arg(QDateTime::currentDateTime().toString(Qt::ISODateWithMs))
+                           .arg(durationNs / 1000000)
+                           .arg(budget)
+                           .arg(finished ? "" : " still running");
+        if (stackDepth > 0) {
+            line += " in";
+            for (int i = 0; i < stackDepth; ++i) {
+                line += QString(i == 0 ? " %1" : " > %1").arg(QString::fromLatin1(stack[i]));
+            }
+        }
+        return line + " " + target(receiver, type);
+    };
+
+    auto describeLatency = [&](qint64 durationNs, quint32 seq, bool finished) {
+        QString line = QString("%1 event-loop latency %2 ms (budget %3 ms)%4, %5 events ahead of the heartbeat")
+                           .arg(QDateTime::currentDateTime().toString(Qt::ISODateWithMs))
+                           .arg(durationNs / 1000000)
+                           .arg(budget)
+                           .arg(finished ? "" : " still waiting")
+                           .arg(int(seq - probeSeq) / 2);
+        if (lastReceiver) line += ", last " + target(lastReceiver, lastType);
+        return line;
+    };
+
+    while (!stopping.loadAcquire()) {
+        msleep(periodMs);
+
+        const quint32 seq = dispatchSeq.loadAcquire();
+        const qint64 since = busySinceNs.load(std::memory_order_relaxed);
+        const qint64 now = clock.nsecsElapsed();
+
+        // (2) heartbeat
+        if (probePosted >= 0) {
+            const qint64 handled = probeHandledNs.load(std::memory_order_acquire);
+            if (handled >= 0) {
+                if (handled - probePosted > budgetNs && !probeCovered) {
+                    writeReport(describeLatency(handled - probePosted, seq, true));
+                }
+                probePosted = -1;
+            } else {
+                if (since >= 0) {
+                    lastReceiver = receiverClass.load();
+                    lastType = eventType.load();
+                }
+                if (!probeCovered && !probeHangReported && now - probePosted > hangNs) {
+                    writeReport(describeLatency(now - probePosted, seq, false));
+                    probeHangReported = true;
+                }
+            }
+        }
+        if (probePosted < 0) {
+            probePosted = clock.nsecsElapsed();
+            probeSeq = seq;
+            probeCovered = false;
+            probeHangReported = false;
+            lastReceiver = nullptr;
+            postProbe();
+        }
+
+        // (1) 最外層事件
+        if (seq != seenSeq || since < 0) {
+            // 上一個事件已經結束
+            if (stalled) {
+                writeReport(describe(lastSample - stallStart + qint64(periodMs) * 1000000 / 2, true));
+                stalled = false;
+            }
+            seenSeq = seq;
+            continue;
+        }
+
+        // 同一個事件還在跑
+        if (!stalled && now - since > budgetNs) {
+            stalled = true;
+            hangReported = false;
+            stallStart = since;
+            receiver = receiverClass.load();
+            type = eventType.load();
+            stackDepth = 0;
+        }
+        if (stalled) {
+            lastSample = now;
+            probeCovered = true;
+            // GUI thread 可能正在推入／彈出；只是診斷用，讀到前後不一致的一層也無妨
+            const int depth = qMin(markDepth.loadAcquire(), int(MAX_MARKS));
+            if (depth > stackDepth) {
+                for (int i = 0; i < depth; ++i) {
+                    stack[i] = marks[i].load();
+                }
+                stackDepth = depth;
+            }
+            if (!hangReported && now - stallStart > hangNs) {
+                writeReport(describe(now - stallStart, false));
+                hangReported = true;
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// writeReport(): 附加一行；檔案超過 MAX_LOG_BYTES 時先換成 .1
+////////////////////////////////////////////////////////////////////////////////
+void StallWatchdog::writeReport(const QString &line)
+{
+    qWarning().noquote() << "[StallWatchdog]" << line;
+
+    const QFileInfo info(path);
+    if (!QDir().mkpath(info.absolutePath())) return;
+    if (info.exists() && info.size() >= MAX_LOG_BYTES) {
+        const QString backup = path + ".1";
+        QFile::remove(backup);
+        QFile::rename(path, backup);
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) return;
+    QTextStream out(&file);
+    out << line << '\n';
+}
@@ -0,0 +1,111 @@
+// StallWatchdog.h
+#pragma once
+
+#include <QAtomicInteger>
+#include <QAtomicPointer>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QString>
+#include <QThread>
+#include <atomic>
+
+/*
+ * StallWatchdog
+ *  - 監看 GUI thread 的事件迴圈，兩種量法：
+ *    (1) 最外層事件：TOSApplication::notify() 以 Dispatch 包住每個事件，只有最外層
+ *        (巢狀的 sendEvent 如 show()/hide()、ChildAdded、Resize、Paint 不算) 記下開始時間、
+ *        receiver 類別與事件種類；同一個最外層事件超過 budget (預設 16 ms) 就記一筆
+ *        (queued slot 是 MetaCall、QTimer / QTimer::singleShot 是 Timer)
+ *    (2) heartbeat：watchdog thread 定期貼一個 probe 事件給 GUI thread，量它等了多久才被處理；
+ *        每個事件都很短、但排了一長串時 (1) 抓不到，這裡會記一筆 "event-loop latency"
+ *  - 巢狀事件迴圈 (exec()) 睡著時視為閒置，之後在那一層派送的事件當作最外層
+ *  - Mark 在 slot 裡標上名稱 (例如 "GameStageWidget::showBoard")，巢狀的 Mark 形成一個小堆疊；
+ *    報告列出卡住期間看到的最深一層堆疊 (例如 onWaveCleared > showEnemies)
+ *  - GUI thread 這一側只做幾次 atomic 寫入；watchdog thread 每 budget/4 取樣一次，
+ *    事件結束時才寫出報告，超過 HANG_MS 還沒結束的先寫一筆 "still running"
+ *  - 報告寫到 <AppLocalData>/stalls.log，超過 MAX_LOG_BYTES 時換成 stalls.log.1 (只留一份舊檔)
+ *
+ *  budget 由環境變數 TOS_STALL_BUDGET_MS 設定；0 表示關閉
+ */
+class StallWatchdog : public QThread
+{
+    Q_OBJECT
+
+public:
+    static constexpr int    DEFAULT_BUDGET_MS = 16;
+    static constexpr int    HANG_MS           = 1000;
+    static constexpr qint64 MAX_LOG_BYTES     = 256 * 1024;
+    static constexpr int    MAX_MARKS         = 4;      // Mark 堆疊只記錄最外面幾層
+
+    // slot 名稱標記：建構時推入堆疊，解構時彈出 (只在 GUI thread 使用)
+    class Mark
+    {
+    public:
+        explicit Mark(const char *name)
+        {
+            const int depth = markDepth.load();
+            if (depth < MAX_MARKS) marks[depth].store(name);
+            markDepth.storeRelease(depth + 1);
+        }
+        ~Mark() { markDepth.storeRelease(markDepth.load() - 1); }
+
+    private:
+        Q_DISABLE_COPY(Mark)
+    };
+
+    // 包住 GUI thread 的一次事件派送 (由 TOSApplication::notify() 使用)；沒有 watchdog 時不做事
+    class Dispatch
+    {
+    public:
+        Dispatch(QObject *receiver, QEvent *event);
+        ~Dispatch();
+
+    private:
+        Q_DISABLE_COPY(Dispatch)
+        StallWatchdog *watchdog;
+    };
+
+    // 需在 QApplication 建立之後、由 GUI thread 建構；start() 之後開始取樣
+    explicit StallWatchdog(int budgetMs, const QString &logPath, QObject *parent = nullptr);
+    ~StallWatchdog();
+
+    int     budgetMs() const;
+    QString logPath() const;
+
+    // TOS_STALL_BUDGET_MS (沒設定時為 DEFAULT_BUDGET_MS)
+    static int configuredBudgetMs();
+    static QString defaultLogPath();
+
+protected:
+    bool event(QEvent *event) override;     // GUI thread：處理 heartbeat probe
+    void run() override;
+
+private:
+    void markBusy(const char *receiver, int type);
+    void markIdle();
+    void postProbe();
+    void writeReport(const QString &line);
+
+    static QEvent::Type probeEventType();
+
+    static QAtomicPointer<const char> marks[MAX_MARKS];
+    static QAtomicInt                 markDepth;
+    static StallWatchdog             *active;           // GUI thread 使用
+
+    const int       budget;
+    const QString   path;
+    QElapsedTimer   clock;
+
+    // GUI thread 專用：Dispatch 的巢狀深度與目前事件迴圈所在的深度
+    int             dispatchDepth;
+    int             loopDepth;
+
+    // GUI thread 寫、watchdog thread 讀
+    QAtomicInteger<quint32>     dispatchSeq;        // 每個最外層事件開始、結束時各加一
+    std::atomic<qint64>         busySinceNs;        // 目前最外層事件的開始時間；-1 表示閒置
+    QAtomicPointer<const char>  receiverClass;
+    QAtomicInt                  eventType;
+    std::atomic<qint64>         probeHandledNs;     // 最近一個 probe 被處理的時間；-1 表示還在等
+
+    QAtomicInt                  stopping;
+};
@@ -0,0 +1,18 @@
+// TOSApplication.cpp
+#include "TOSApplication.h"
+#include "StallWatchdog.h"
+#include <QThread>
+
+TOSApplication::TOSApplication(int &argc, char **argv)
+    : QApplication(argc, argv)
+{
+}
+
+bool TOSApplication::notify(QObject *receiver, QEvent *event)
+{
+    if (QThread::currentThread() != thread()) {
+        return QApplication::notify(receiver, event);
+    }
+    StallWatchdog::Dispatch dispatch(receiver, event);
+    return QApplication::notify(receiver, event);
+}
@@ -0,0 +1,18 @@
+// TOSApplication.h
+#pragma once
+
+#include <QApplication>
+
+/*
+ * TOSApplication
+ *  - QApplication 加上一個 notify() 掛勾：GUI thread 派送的每個事件 (含巢狀的 sendEvent)
+ *    都先經過 StallWatchdog::Dispatch，watchdog 才分得出哪個是最外層事件
+ *  - 其他 thread 的事件直接交給 QApplication::notify()
+ */
+class TOSApplication : public QApplication
+{
+public:
+    TOSApplication(int &argc, char **argv);
+
+    bool notify(QObject *receiver, QEvent *event) override;
+};
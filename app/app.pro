@@ -0,0 +1,68 @@
+QT       += core gui
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets concurrent
+
+CONFIG += c++11
+
+TARGET = TOS
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+include(../core/core.pri)
+
+SOURCES += \
+    AssetPreloader.cpp \
+    BoardWidget.cpp \
+    FinishStageWidget.cpp \
+    FrameClock.cpp \
+    GameController.cpp \
+    GameEventChannel.cpp \
+    GameStageWidget.cpp \
+    GemSprite.cpp \
+    HintEngine.cpp \
+    PerfOverlay.cpp \
+    PerfStats.cpp \
+    PauseWidget.cpp \
+    PrepareStageWidget.cpp \
+    SpriteCache.cpp \
+    StallWatchdog.cpp \
+    TOSApplication.cpp \
+    main.cpp \
+    MainWindow.cpp
+
+HEADERS += \
+    AssetPreloader.h \
+    BoardWidget.h \
+    FinishStageWidget.h \
+    FrameClock.h \
+    GameController.h \
+    GameEventChannel.h \
+    GameStageWidget.h \
+    GemSprite.h \
+    HintEngine.h \
+    PerfOverlay.h \
+    PerfStats.h \
+    PauseWidget.h \
+    PrepareStageWidget.h \
+    SpriteCache.h \
+    StallWatchdog.h \
+    TOSApplication.h \
+    MainWindow.h
+
+FORMS += \
+    ../mainwindow.ui
+
+TRANSLATIONS += \
+    ../TOS_zh_TW.ts
+CONFIG += lrelease
+CONFIG += embed_translations
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
+
+RESOURCES += \
+    ../data.qrc
@@ -0,0 +1,50 @@
+#include "AssetPreloader.h"
+#include "MainWindow.h"
+#include "MissionTable.h"
+#include "StallWatchdog.h"
+#include "TOSApplication.h"
+#include "Trace.h"
+
+#include <QDebug>
+#include <QLocale>
+#include <QScopedPointer>
+#include <QScreen>
+#include <QTranslator>
+
+int main(int argc, char *argv[])
+{
+    TOSApplication a(argc, argv);
+
+    QTranslator translator;
+    const QStringList uiLanguages = QLocale::system().uiLanguages();
+    for (const QString &locale : uiLanguages) {
+        const QString baseName = "TOS_" + QLocale(locale).name();
+        if (translator.load(":/i18n/" + baseName)) {
+            a.installTranslator(&translator);
+            break;
+        }
+    }
+    // mission 定義檔在啟動時解析一次，之後開始 mission 只是查表
+    MissionTable::shared();
+
+    // 圖檔在 worker thread 上平行解碼；Prepare 畫面不必等，Start 只等選到的 mission
+    AssetPreloader::instance().start(a.primaryScreen()->devicePixelRatio());
+
+    // 事件迴圈卡頓監看 (TOS_STALL_BUDGET_MS=0 關閉)；最外層事件由 TOSApplication::notify() 標出
+    QScopedPointer<StallWatchdog> watchdog;
+    const int stallBudgetMs = StallWatchdog::configuredBudgetMs();
+    if (stallBudgetMs > 0) {
+        watchdog.reset(new StallWatchdog(stallBudgetMs, StallWatchdog::defaultLogPath()));
+        watchdog->start(QThread::LowPriority);
+    }
+
+    MainWindow w;
+    w.show();
+    const int ret = a.exec();
+
+#ifdef TOS_TRACE
+    // 以 CONFIG+=trace 建置時，結束前把整段執行的 trace 存檔
+    qDebug() << "[main] trace written to" << Trace::writeDefault();
+#endif
+    return ret;
+}
@@ -0,0 +1,129 @@
+// BitBoard.h
+#pragma once
+
+#include <QtGlobal>
+#include <QtAlgorithms>
+
+/*
+ * BitBoard
+ *  - 5×6 盤面以 32-bit 位元遮罩表示，第 (r,c) 格對應 bit (r * COLS + c)
+ *  - 每種符石屬性一張 plane；橫/直 ≥ 3 連線以「位移 + AND」一次找出
+ *  - 連線格子再依「同屬性、上下左右相連」切成 combo 群組
+ *  - 全部運算都在堆疊上完成，不做任何 heap 配置
+ */
+namespace BitBoard
+{
+    typedef quint32 Mask;
+
+    static constexpr int ROWS       = 5;
+    static constexpr int COLS       = 6;
+    static constexpr int CELLS      = ROWS * COLS;
+    static constexpr int ATTR_COUNT = 5;            // 對應 Gem::Attribute
+    static constexpr int MAX_COMBOS = CELLS / 3;    // 每個 combo 至少 3 格
+
+    static constexpr Mask FULL = (Mask(1) << CELLS) - 1;
+
+    // 每列第 c 欄的位元 (c = 0..COLS-1)，用來組出各種欄遮罩
+    static constexpr Mask columnMask(int c)
+    {
+        return (Mask(1) << (0 * COLS + c)) | (Mask(1) << (1 * COLS + c)) |
+               (Mask(1) << (2 * COLS + c)) | (Mask(1) << (3 * COLS + c)) |
+               (Mask(1) << (4 * COLS + c));
+    }
+
+    static constexpr Mask rowMask(int r)
+    {
+        return ((Mask(1) << COLS) - 1) << (r * COLS);
+    }
+
+    static constexpr Mask FIRST_COL = columnMask(0);
+    static constexpr Mask LAST_COL  = columnMask(COLS - 1);
+
+    // 橫向連線的起點只能落在 c <= COLS-3，避免跨列誤判
+    static constexpr Mask H_START = FULL & ~columnMask(COLS - 2) & ~columnMask(COLS - 1);
+
+    static_assert(CELLS <= 32, "board must fit in a 32-bit mask");
+
+    inline Mask bit(int r, int c)
+    {
+        return Mask(1) << (r * COLS + c);
+    }
+
+    inline int rowOf(int index) { return index / COLS; }
+    inline int colOf(int index) { return index % COLS; }
+
+    inline int count(Mask m)
+    {
+        return int(qPopulationCount(m));
+    }
+
+    // 取出最低位元的 index；呼叫端需保證 m != 0
+    inline int lowestIndex(Mask m)
+    {
+        return int(qCountTrailingZeroBits(m));
+    }
+
+    // 取出最高位元的 index；呼叫端需保證 m != 0
+    inline int highestIndex(Mask m)
+    {
+        return 31 - int(qCountLeadingZeroBits(m));
+    }
+
+    // 一個屬性 plane 上所有 ≥ 3 連線的格子
+    inline Mask findRuns(Mask plane)
+    {
+        const Mask h = plane & (plane >> 1) & (plane >> 2) & H_START;
+        const Mask v = plane & (plane >> COLS) & (plane >> (2 * COLS));
+        return (h | (h << 1) | (h << 2)) |
+               (v | (v << COLS) | (v << (2 * COLS)));
+    }
+
+    // 上下左右擴張一格 (不跨列、不超出盤面)
+    inline Mask grow(Mask m)
+    {
+        return (m | ((m << 1) & ~FIRST_COL) | ((m >> 1) & ~LAST_COL) |
+                (m << COLS) | (m >> COLS)) & FULL;
+    }
+
+    // 每種屬性一張 plane
+    struct Planes
+    {
+        Mask attr[ATTR_COUNT];
+    };
+
+    struct MatchResult
+    {
+        Mask   matched;                     // 所有要消除的格子
+        Mask   attrMatched[ATTR_COUNT];     // 依屬性分開的消除格子
+        int    comboCount;                  // combo 數 (相連群組數)
+        Mask   comboMask[MAX_COMBOS];       // 每個 combo 的格子
+        quint8 comboAttr[MAX_COMBOS];       // 每個 combo 的屬性
+    };
+
+    // 找出所有連線格子並切成 combo 群組
+    inline void findMatches(const Planes &planes, MatchResult &out)
+    {
+        out.matched = 0;
+        out.comboCount = 0;
+
+        for (int a = 0; a < ATTR_COUNT; ++a) {
+            Mask runs = findRuns(planes.attr[a]);
+            out.attrMatched[a] = runs;
+            out.matched |= runs;
+
+            // 以最低位元為種子做 flood fill，直到該屬性的連線格子分完
+            while (runs) {
+                Mask group = runs & (~runs + 1);
+                for (;;) {
+                    Mask next = grow(group) & runs;
+                    if (next == group) break;
+                    group = next;
+                }
+                out.comboMask[out.comboCount] = group;
+                out.comboAttr[out.comboCount] = quint8(a);
+                ++out.comboCount;
+                runs &= ~group;
+            }
+        }
+    }
+}
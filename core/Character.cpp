@@ -0,0 +1,150 @@
+#include "Character.h"
+
+Character::Character()
+    : index(-1),
+      id(0)
+{
+}
+
+// 建構子（原本就放在 .cpp 裡）：自己持有一格 Combatants
+Character::Character(int id,
+                     Attribute attr,
+                     int totalPlayerHP,
+                     int numSelectedChars,
+                     const QString &iconPath)
+    : unitData(std::make_shared<Combatants>()),
+      index(0),
+      id(id),
+      iconPath(iconPath)
+{
+    unitData->add(splitHP(totalPlayerHP, numSelectedChars), 1, attr, 0);
+}
+
+Character::Character(const std::shared_ptr<Combatants> &units, int index,
+                     int id, const QString &iconPath)
+    : unitData(units),
+      index(index),
+      id(id),
+      iconPath(iconPath)
+{
+}
+
+int Character::splitHP(int totalPlayerHP, int numSelectedChars)
+{
+    if (numSelectedChars > 0) {
+        return totalPlayerHP / numSelectedChars;
+    }
+    return totalPlayerHP;
+}
+
+// ★ 在這裡才真正實作一次 virtual destructor ★
+Character::~Character()
+{
+
+}
+
+Character::Attribute Character::attributeForID(int id)
+{
+    switch (id) {
+        case 1: return Water;
+        case 2: return Fire;
+        case 3: return Earth;
+        case 4: return Light;
+        case 5: return Dark;
+        case 6: return Water;
+        default: return Water;
+    }
+}
+
+QString Character::iconPathFor(int id)
+{
+    return QString(":/character/dataset/character/ID%1.png").arg(id);
+}
+
+QVector<Character*> Character::createParty(const QVector<int> &selectedIDs, int totalHP)
+{
+    // 算一共有幾隻非 0 的角色
+    int numChars = 0;
+    for (int id : selectedIDs) {
+        if (id > 0) ++numChars;
+    }
+
+    // 整隊共用一份 Combatants，GameEngine::init() 可以直接接手
+    auto units = std::make_shared<Combatants>();
+    units->reserve(numChars);
+
+    QVector<Character*> party;
+    for (int id : selectedIDs) {
+        if (id <= 0) continue;
+        QString iconPath = iconPathFor(id);
+        int hpPerChar = (numChars > 0) ? (totalHP / numChars) : totalHP;
+        const int index = units->add(splitHP(hpPerChar, numChars), 1, attributeForID(id), 0);
+        party.append(new Character(units, index, id, iconPath));
+    }
+    return party;
+}
+
+// 以下為其他成員函式的實作……
+// 比如：
+int Character::getID() const { return id; }
+Character::Attribute Character::getAttribute() const { return static_cast<Attribute>(unitData->attribute(index)); }
+int Character::getMaxHP() const { return unitData->maxHP(index); }
+int Character::getCurrentHP() const { return unitData->hp(index); }
+int Character::getAttackPower() const { return unitData->attack(index); }
+QString Character::getIconPath() const { return iconPath; }
+
+void Character::takeDamage(int damage)
+{
+    unitData->damage(index, damage);
+}
+
+void Character::setCurrentHP(int hp)
+{
+    unitData->setHP(index, hp);
+}
+
+
+bool Character::isAlive() const
+{
+    return unitData->hp(index) > 0;
+}
+
+void Character::reset()
+{
+    unitData->setHP(index, unitData->maxHP(index));
+}
+
+int Character::calculateDamageOutput(const Damage::Input &in) const
+{
+    if (!isAlive()) return 0;
+    const int attr = unitData->attribute(index);
+    return Damage::unitDamage(unitData->attack(index), in.clearedCount[attr],
+                              Damage::comboPercent(in.comboCount),
+                              Damage::advantagePercent(attr, in.defender));
+}
+
+void Character::useSkill(/*int skillIndex, Character &target*/)
+{
+    // 暫時留空
+}
+
+const std::shared_ptr<Combatants> &Character::units() const
+{
+    return unitData;
+}
+
+int Character::unitIndex() const
+{
+    return index;
+}
+
+void Character::bindTo(const std::shared_ptr<Combatants> &target)
+{
+    const Combatants &from = *unitData;
+    const int i = target->add(from.maxHP(index), from.attack(index),
+                              from.attribute(index), from.cooldownDefault(index));
+    target->setHP(i, from.hp(index));
+    target->setCooldown(i, from.cooldown(index));
+    unitData = target;
+    index = i;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <memory>
+#include "Combatants.h"
+#include "Damage.h"
+
+/*
+ * Character
+ *  - 角色的 handle：HP、攻擊力、屬性等數值存在 Combatants 的第 index 格，
+ *    這裡只留 ID 與圖示路徑；複製 handle 不會複製數值
+ *  - 單獨建立的 Character 自己持有一份只有一格的 Combatants；
+ *    createParty() 的隊伍共用一份，GameEngine::init() 直接接手
+ */
+class Character
+{
+public:
+    enum Attribute { Water, Fire, Earth, Light, Dark };
+
+    // 可選的角色 ID 為 1 ~ ROSTER_SIZE
+    static constexpr int ROSTER_SIZE = 5;
+
+    Character();    // 空的 handle (放進容器用)
+
+    Character(int id,
+              Attribute attr,
+              int totalPlayerHP,
+              int numSelectedChars,
+              const QString &iconPath);
+
+    // 指向既有 Combatants 的第 index 格
+    Character(const std::shared_ptr<Combatants> &units, int index,
+              int id, const QString &iconPath);
+
+    virtual ~Character();
+
+    // 角色 ID → 屬性 (此範例 ID 1~5 依序為 Water/Fire/Earth/Light/Dark)
+    static Attribute attributeForID(int id);
+
+    // 角色 ID → 圖示 (data.qrc)
+    static QString iconPathFor(int id);
+
+    // 依 6 格角色 ID (0 表示空格) 建立隊伍，呼叫端負責 delete
+    static QVector<Character*> createParty(const QVector<int> &selectedIDs, int totalHP);
+
+    int getID() const;
+    Attribute getAttribute() const;
+    int getMaxHP() const;
+    int getCurrentHP() const;
+    int getAttackPower() const;
+    QString getIconPath() const;
+
+    void takeDamage(int damage);
+    void setCurrentHP(int hp);      // 限制在 0 ~ maxHP (還原存檔狀態用)
+    bool isAlive() const;
+    virtual void reset();
+    int calculateDamageOutput(const Damage::Input &in) const;    // 與 Damage::teamDamage() 同一公式
+    virtual void useSkill(/*int skillIndex, Character &target*/);
+
+    // 數值所在的 Combatants 與 index
+    const std::shared_ptr<Combatants> &units() const;
+    int unitIndex() const;
+
+    // 把目前數值搬到 target 的尾端，之後改由那一格存放
+    void bindTo(const std::shared_ptr<Combatants> &target);
+
+protected:
+    std::shared_ptr<Combatants> unitData;
+    int index;
+
+private:
+    static int splitHP(int totalPlayerHP, int numSelectedChars);
+
+    int id;
+    QString iconPath;
+};
@@ -0,0 +1,154 @@
+// Combatants.cpp
+#include "Combatants.h"
+
+Combatants::Combatants()
+{
+}
+
+void Combatants::clear()
+{
+    hpValues.resize(0);
+    maxHPValues.resize(0);
+    attackValues.resize(0);
+    cooldownValues.resize(0);
+    cooldownDefaults.resize(0);
+    attributes.resize(0);
+}
+
+void Combatants::reserve(int count)
+{
+    hpValues.reserve(count);
+    maxHPValues.reserve(count);
+    attackValues.reserve(count);
+    cooldownValues.reserve(count);
+    cooldownDefaults.reserve(count);
+    attributes.reserve(count);
+}
+
+int Combatants::add(int maxHP, int attack, int attribute, int cooldownDefault)
+{
+    maxHP = qMax(0, maxHP);
+    hpValues.append(maxHP);
+    maxHPValues.append(maxHP);
+    attackValues.append(attack);
+    cooldownValues.append(cooldownDefault);
+    cooldownDefaults.append(cooldownDefault);
+    attributes.append(quint8(attribute));
+    return hpValues.size() - 1;
+}
+
+int Combatants::size() const
+{
+    return hpValues.size();
+}
+
+void Combatants::setHP(int i, int hp)
+{
+    hpValues[i] = qBound(0, hp, maxHPValues[i]);
+}
+
+void Combatants::setCooldown(int i, int cooldown)
+{
+    cooldownValues[i] = cooldown;
+}
+
+void Combatants::damage(int i, int amount)
+{
+    hpValues[i] = qMax(0, hpValues[i] - amount);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 批次運算：迴圈裡只讀連續的 int 陣列，沒有分支以外的相依
+////////////////////////////////////////////////////////////////////////////////
+bool Combatants::anyAlive(int begin, int end) const
+{
+    return aliveCount(begin, end) > 0;
+}
+
+int Combatants::aliveCount(int begin, int end) const
+{
+    const int *hp = hpValues.constData();
+    int count = 0;
+    for (int i = begin; i < end; ++i) {
+        count += hp[i] > 0 ? 1 : 0;
+    }
+    return count;
+}
+
+int Combatants::firstAlive(int begin, int end) const
+{
+    const int *hp = hpValues.constData();
+    for (int i = begin; i < end; ++i) {
+        if (hp[i] > 0) return i;
+    }
+    return -1;
+}
+
+int Combatants::aliveAttack(int begin, int end) const
+{
+    const int *hp = hpValues.constData();
+    const int *atk = attackValues.constData();
+    int total = 0;
+    for (int i = begin; i < end; ++i) {
+        total += hp[i] > 0 ? atk[i] : 0;
+    }
+    return total;
+}
+
+int Combatants::totalHP(int begin, int end) const
+{
+    const int *hp = hpValues.constData();
+    int total = 0;
+    for (int i = begin; i < end; ++i) {
+        total += hp[i];
+    }
+    return total;
+}
+
+int Combatants::takeHits(int begin, int end,
+                         const Combatants &attackers, int attackerBegin, int attackerEnd)
+{
+    int target = firstAlive(begin, end);
+    if (target < 0) return 0;
+
+    // 常見情況：所有攻擊加起來也打不倒目前的目標，每一下都落在它身上，
+    // 用 (可向量化的) 攻擊力加總一次扣完，結果與逐一出手相同
+    int *hp = hpValues.data();
+    const int total = attackers.aliveAttack(attackerBegin, attackerEnd);
+    if (total < hp[target]) {
+        hp[target] -= total;
+        return total;
+    }
+
+    // 目標會倒下：逐一出手，倒下後下一擊換到下一個活著的單位
+    const int *attackerHP = attackers.hpValues.constData();
+    const int *atk = attackers.attackValues.constData();
+    int landed = 0;
+    for (int i = attackerBegin; i < attackerEnd && target >= 0; ++i) {
+        if (attackerHP[i] <= 0) continue;
+        hp[target] = qMax(0, hp[target] - atk[i]);
+        landed += atk[i];
+        if (hp[target] == 0) target = firstAlive(target + 1, end);
+    }
+    return landed;
+}
+
+void Combatants::kill(int begin, int end)
+{
+    int *hp = hpValues.data();
+    for (int i = begin; i < end; ++i) {
+        hp[i] = 0;
+    }
+}
+
+void Combatants::revive(int begin, int end)
+{
+    int *hp = hpValues.data();
+    int *cd = cooldownValues.data();
+    const int *maxHP = maxHPValues.constData();
+    const int *cdDefault = cooldownDefaults.constData();
+    for (int i = begin; i < end; ++i) {
+        hp[i] = maxHP[i];
+        cd[i] = cdDefault[i];
+    }
+}
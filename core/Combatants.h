@@ -0,0 +1,63 @@
+// Combatants.h
+#pragma once
+
+#include <QVector>
+
+/*
+ * Combatants
+ *  - 一組戰鬥單位 (一支隊伍，或一個 mission 所有波次的敵人) 以 structure-of-arrays 存放：
+ *    HP、最大 HP、攻擊力、屬性、cooldown 各是一條連續的陣列
+ *  - 整個敵人回合、全隊攻擊都是對 [begin, end) 區間的簡單迴圈：沒有虛擬呼叫、
+ *    沒有指標追逐，編譯器可以向量化；一波幾百隻敵人也只是幾條陣列的加總
+ *  - Character / Enemy 只是 (Combatants, index) 的 handle，數值都存在這裡
+ *  - HP 一律限制在 0 ~ maxHP
+ */
+class Combatants
+{
+public:
+    Combatants();
+
+    // 清空 (保留容量，下一局重複使用)
+    void clear();
+    void reserve(int count);
+
+    // 加入一個單位 (滿血、cooldown 為預設值)；回傳 index
+    int  add(int maxHP, int attack, int attribute, int cooldownDefault);
+    int  size() const;
+
+    // 單一單位
+    int  hp(int i) const              { return hpValues[i]; }
+    int  maxHP(int i) const           { return maxHPValues[i]; }
+    int  attack(int i) const          { return attackValues[i]; }
+    int  attribute(int i) const       { return attributes[i]; }
+    int  cooldown(int i) const        { return cooldownValues[i]; }
+    int  cooldownDefault(int i) const { return cooldownDefaults[i]; }
+
+    void setHP(int i, int hp);
+    void setCooldown(int i, int cooldown);
+    void damage(int i, int amount);
+
+    // [begin, end) 區間的批次運算
+    bool anyAlive(int begin, int end) const;
+    int  aliveCount(int begin, int end) const;
+    int  firstAlive(int begin, int end) const;      // 沒有回傳 -1
+    int  aliveAttack(int begin, int end) const;     // 活著的單位攻擊力總和
+    int  totalHP(int begin, int end) const;
+
+    // attackers 的 [attackerBegin, attackerEnd) 裡活著的單位依序各出手一次，
+    // 每一下打在 [begin, end) 第一個活著的單位；倒下時多出來的傷害不轉給下一個。
+    // 回傳命中的攻擊力總和
+    int  takeHits(int begin, int end,
+                  const Combatants &attackers, int attackerBegin, int attackerEnd);
+
+    void kill(int begin, int end);                  // HP 歸 0
+    void revive(int begin, int end);                // 滿血、cooldown 回到預設值
+
+private:
+    QVector<int>    hpValues;
+    QVector<int>    maxHPValues;
+    QVector<int>    attackValues;
+    QVector<int>    cooldownValues;
+    QVector<int>    cooldownDefaults;
+    QVector<quint8> attributes;
+};
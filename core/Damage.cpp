@@ -0,0 +1,31 @@
+// Damage.cpp
+#include "Damage.h"
+#include "Combatants.h"
+
+namespace Damage
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// teamDamage(): combo 倍率整隊只算一次；每個角色查一次相剋表
+////////////////////////////////////////////////////////////////////////////////
+void teamDamage(const Combatants &party, int begin, int end, const Input &in, Result &out)
+{
+    const int comboPct = comboPercent(in.comboCount);
+
+    out.total = 0;
+    out.unitCount = 0;
+    for (int i = begin; i < end; ++i) {
+        int dealt = 0;
+        if (party.hp(i) > 0) {
+            const int attr = party.attribute(i);
+            dealt = unitDamage(party.attack(i), in.clearedCount[attr], comboPct,
+                               advantagePercent(attr, in.defender));
+        }
+        out.total += dealt;
+        if (out.unitCount < MAX_TEAM) {
+            out.perUnit[out.unitCount++] = dealt;
+        }
+    }
+}
+
+} // namespace Damage
@@ -0,0 +1,77 @@
+// Damage.h
+#pragma once
+
+#include <QtGlobal>
+#include "BitBoard.h"
+
+class Combatants;
+
+/*
+ * Damage
+ *  - 一次消除的傷害：每個角色 = 攻擊力 × 自己屬性的消除格數 × combo 倍率 × 屬性相剋倍率
+ *  - 倍率一律是百分比整數；相剋表與 combo 倍率都是 constexpr，編譯期就定好
+ *  - 屬性相剋：Water > Fire > Earth > Water，Light ⇄ Dark 互剋 (剋制 150%、被剋 50%)
+ *  - teamDamage() 一次掃完隊伍的 Combatants 區間，只用堆疊上的定長陣列，不做 heap 配置
+ */
+namespace Damage
+{
+    static constexpr int PERCENT        = 100;
+    static constexpr int STRONG_PERCENT = 150;
+    static constexpr int WEAK_PERCENT   = 50;
+    static constexpr int COMBO_STEP     = 25;     // 每多 1 combo 多 25%
+    static constexpr int MAX_TEAM       = 8;      // Result::perUnit 的大小
+    static constexpr int NO_DEFENDER    = -1;     // 沒有目標：不算相剋
+
+    // [攻擊方屬性][防守方屬性]，順序同 Character::Attribute / Gem::Attribute
+    static constexpr int ATTRIBUTE_PERCENT[BitBoard::ATTR_COUNT][BitBoard::ATTR_COUNT] = {
+        //  Water          Fire            Earth           Light           Dark
+        { PERCENT,        STRONG_PERCENT, WEAK_PERCENT,   PERCENT,        PERCENT        },  // Water
+        { WEAK_PERCENT,   PERCENT,        STRONG_PERCENT, PERCENT,        PERCENT        },  // Fire
+        { STRONG_PERCENT, WEAK_PERCENT,   PERCENT,        PERCENT,        PERCENT        },  // Earth
+        { PERCENT,        PERCENT,        PERCENT,        PERCENT,        STRONG_PERCENT },  // Light
+        { PERCENT,        PERCENT,        PERCENT,        STRONG_PERCENT, PERCENT        },  // Dark
+    };
+
+    static constexpr int advantagePercent(int attacker, int defender)
+    {
+        return defender < 0 ? PERCENT : ATTRIBUTE_PERCENT[attacker][defender];
+    }
+
+    // 1 combo = 100%，之後每多一個 +COMBO_STEP
+    static constexpr int comboPercent(int comboCount)
+    {
+        return comboCount <= 1 ? PERCENT : PERCENT + COMBO_STEP * (comboCount - 1);
+    }
+
+    // 單一角色的傷害 (四捨五入到整數)
+    static constexpr int unitDamage(int attack, int cleared, int comboPct, int advantagePct)
+    {
+        return int((qint64(attack) * cleared * comboPct * advantagePct + PERCENT * PERCENT / 2)
+                   / (PERCENT * PERCENT));
+    }
+
+    static_assert(advantagePercent(0, 1) == STRONG_PERCENT &&
+                  advantagePercent(1, 2) == STRONG_PERCENT &&
+                  advantagePercent(2, 0) == STRONG_PERCENT, "Water > Fire > Earth > Water");
+    static_assert(advantagePercent(3, 4) == STRONG_PERCENT &&
+                  advantagePercent(4, 3) == STRONG_PERCENT, "Light <> Dark");
+    static_assert(unitDamage(1, 3, comboPercent(1), PERCENT) == 3, "single combo is unscaled");
+
+    // 一次結算的輸入：各屬性消除格數 (含 cascade)、combo 總數、目標的屬性
+    struct Input
+    {
+        int clearedCount[BitBoard::ATTR_COUNT];
+        int comboCount;
+        int defender;
+    };
+
+    struct Result
+    {
+        int total;
+        int unitCount;                  // perUnit 有效的筆數 (最多 MAX_TEAM)
+        int perUnit[MAX_TEAM];          // 隊伍第 i 格的傷害 (倒下的角色為 0)
+    };
+
+    // 隊伍 party 的 [begin, end) 一起攻擊；只有活著的角色出手
+    void teamDamage(const Combatants &party, int begin, int end, const Input &in, Result &out);
+}
@@ -0,0 +1,417 @@
+// DragSolver.cpp
+#include "DragSolver.h"
+#include "Combatants.h"
+#include "Damage.h"
+#include <QElapsedTimer>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+// Zobrist 表：每格每種內容 (5 種屬性 + 空格) 一個 key，另外每格一個「手上符石」key
+////////////////////////////////////////////////////////////////////////////////
+struct ZobristKeys
+{
+    quint64 gem[BitBoard::CELLS][BitBoard::ATTR_COUNT + 1];
+    quint64 held[BitBoard::CELLS];
+
+    ZobristKeys()
+    {
+        // 固定種子的 splitmix64，每次執行 hash 都一樣
+        quint64 s = Q_UINT64_C(0x544f53536f6c7665);
+        auto next = [&s]() {
+            quint64 z = (s += Q_UINT64_C(0x9e3779b97f4a7c15));
+            z = (z ^ (z >> 30)) * Q_UINT64_C(0xbf58476d1ce4e5b9);
+            z = (z ^ (z >> 27)) * Q_UINT64_C(0x94d049bb133111eb);
+            return z ^ (z >> 31);
+        };
+        for (auto &cell : gem) {
+            for (quint64 &key : cell) key = next();
+        }
+        for (quint64 &key : held) key = next();
+    }
+};
+
+const ZobristKeys &zobrist()
+{
+    static const ZobristKeys keys;
+    return keys;
+}
+
+inline int contentOf(const Gem &g)
+{
+    return g.isEmpty() ? BitBoard::ATTR_COUNT : int(g.getType());
+}
+
+quint64 hashBoard(const GemBoard &board, int heldCell)
+{
+    const ZobristKeys &z = zobrist();
+    quint64 h = z.held[heldCell];
+    for (int i = 0; i < GemBoard::CELLS; ++i) {
+        h ^= z.gem[i][contentOf(board.cell(i))];
+    }
+    return h;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// TranspositionTable: 開放定址的 hash set，只存 64-bit key
+//    搜尋時多條 thread 同時查詢；寫入只在單執行緒的篩選階段進行
+////////////////////////////////////////////////////////////////////////////////
+class TranspositionTable
+{
+public:
+    explicit TranspositionTable(int minEntries)
+    {
+        int size = 1024;
+        while (size < minEntries * 2) size <<= 1;
+        slots.assign(size, 0);
+        mask = size - 1;
+    }
+
+    bool contains(quint64 key) const
+    {
+        key = key ? key : 1;
+        for (int i = int(key) & mask; ; i = (i + 1) & mask) {
+            if (slots[i] == key) return true;
+            if (slots[i] == 0) return false;
+        }
+    }
+
+    // 已存在則回傳 false
+    bool insert(quint64 key)
+    {
+        key = key ? key : 1;
+        for (int i = int(key) & mask; ; i = (i + 1) & mask) {
+            if (slots[i] == key) return false;
+            if (slots[i] == 0) {
+                slots[i] = key;
+                return true;
+            }
+        }
+    }
+
+private:
+    std::vector<quint64> slots;
+    int                  mask;
+};
+
+struct Node
+{
+    GemBoard         board;
+    quint64          hash;
+    DragSolver::Path path;
+    quint32          order;     // parentIndex * 4 + direction，排序時保持結果可重現
+    qint64           score;
+    int              comboCount;
+    int              clearedCells;
+    int              damage;
+};
+
+// combo 優先，其次傷害 (有 Attackers 時) 或消除格數
+inline qint64 scoreOf(const DragSolver::Attackers &attackers,
+                      int comboCount, int clearedCells, int damage)
+{
+    return (qint64(comboCount) << 32) + (attackers.party ? damage : clearedCells);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 展開用的 thread pool：第一次 solve() 時建立，thread 不會閒置回收
+//    不用 QThreadPool::globalInstance()，避免和 HintEngine 等 QtConcurrent 工作互相佔位
+////////////////////////////////////////////////////////////////////////////////
+QThreadPool &solverPool()
+{
+    static QThreadPool *pool = []() {
+        QThreadPool *p = new QThreadPool;
+        p->setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+        p->setExpiryTimeout(-1);
+        return p;
+    }();
+    return *pool;
+}
+
+// 一層裡一個 helper 的工作；結束時 release() 一次，呼叫端以 acquire() 等全部完成
+class ExpandTask : public QRunnable
+{
+public:
+    ExpandTask(const std::function<void(int)> &work, int worker, QSemaphore &done)
+        : work(work), worker(worker), done(done)
+    {
+    }
+
+    void run() override
+    {
+        work(worker);
+        done.release();
+    }
+
+private:
+    const std::function<void(int)> &work;
+    const int                       worker;
+    QSemaphore                     &done;
+};
+
+const int DR[4] = { -1, 1, 0, 0 };
+const int DC[4] = { 0, 0, -1, 1 };
+const int OPPOSITE[4] = { DragSolver::Down, DragSolver::Up,
+                          DragSolver::Right, DragSolver::Left };
+
+} // namespace
+
+DragSolver::Config::Config()
+    : maxSteps(24),
+      beamWidth(1000),
+      threads(0),
+      timeBudgetMs(2000)
+{
+}
+
+DragSolver::Attackers::Attackers()
+    : party(nullptr),
+      begin(0),
+      end(0),
+      defender(Damage::NO_DEFENDER)
+{
+}
+
+DragSolver::Attackers::Attackers(const Combatants &p, int b, int e, int d)
+    : party(&p),
+      begin(b),
+      end(e),
+      defender(d)
+{
+}
+
+DragSolver::DragSolver(const Config &c)
+    : config(c)
+{
+    config.maxSteps = qBound(1, config.maxSteps, int(MAX_PATH));
+    config.beamWidth = qMax(1, config.beamWidth);
+    if (config.threads <= 0) {
+        config.threads = qMax(1, QThread::idealThreadCount());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Path::cellAt() / stepCells() / applyPath()
+////////////////////////////////////////////////////////////////////////////////
+int DragSolver::Path::cellAt(int step) const
+{
+    int r = BitBoard::rowOf(startCell);
+    int c = BitBoard::colOf(startCell);
+    for (int i = 0; i < step && i < length; ++i) {
+        r += DR[steps[i]];
+        c += DC[steps[i]];
+    }
+    return r * GemBoard::COLS + c;
+}
+
+void DragSolver::stepCells(const Path &path, int step, int &r1, int &c1, int &r2, int &c2)
+{
+    const int from = path.cellAt(step);
+    r1 = BitBoard::rowOf(from);
+    c1 = BitBoard::colOf(from);
+    r2 = r1 + DR[path.steps[step]];
+    c2 = c1 + DC[path.steps[step]];
+}
+
+GemBoard DragSolver::applyPath(const GemBoard &board, const Path &path)
+{
+    GemBoard b = board;
+    for (int i = 0; i < path.length; ++i) {
+        int r1, c1, r2, c2;
+        stepCells(path, i, r1, c1, r2, c2);
+        b.swap(r1, c1, r2, c2);
+    }
+    return b;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// evaluate(): 消除 → 下落 → 再判定，不補新，直到盤面穩定
+//    有 Attackers 時以各屬性消除格數與 combo 總數算一次全隊傷害
+////////////////////////////////////////////////////////////////////////////////
+void DragSolver::evaluate(const GemBoard &board, int &comboCount, int &clearedCells)
+{
+    int damage;
+    evaluate(board, Attackers(), comboCount, clearedCells, damage);
+}
+
+void DragSolver::evaluate(const GemBoard &board, const Attackers &attackers,
+                          int &comboCount, int &clearedCells, int &damage)
+{
+    GemBoard b = board;
+    BitBoard::MatchResult match;
+    Damage::Input in = Damage::Input();
+    comboCount = 0;
+    clearedCells = 0;
+    damage = 0;
+
+    for (;;) {
+        BitBoard::findMatches(b.planes(), match);
+        if (!match.matched) break;
+        comboCount += match.comboCount;
+        clearedCells += BitBoard::count(match.matched);
+        if (attackers.party) {
+            for (int a = 0; a < BitBoard::ATTR_COUNT; ++a) {
+                in.clearedCount[a] += BitBoard::count(match.attrMatched[a]);
+            }
+        }
+
+        BitBoard::Mask cells = match.matched;
+        while (cells) {
+            b.cell(BitBoard::lowestIndex(cells)) = Gem::empty();
+            cells &= cells - 1;
+        }
+        b.collapse();
+    }
+
+    if (attackers.party && comboCount > 0) {
+        in.comboCount = comboCount;
+        in.defender = attackers.defender;
+        Damage::Result out;
+        Damage::teamDamage(*attackers.party, attackers.begin, attackers.end, in, out);
+        damage = out.total;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// solve(): 平行 beam search
+//    1. 第 0 層：30 個起點
+//    2. 每層：多條 thread 展開候選 (查置換表、評分)
+//    3. 單執行緒依分數排序，寫入置換表並保留前 beamWidth 個
+////////////////////////////////////////////////////////////////////////////////
+DragSolver::Result DragSolver::solve(const GemBoard &board, const Attackers &attackers,
+                                     const QAtomicInt *generation, int token) const
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    Result result = Result();
+    result.boardAfter = board;
+    qint64 bestScore = -1;
+
+    const ZobristKeys &z = zobrist();
+    TranspositionTable table(config.beamWidth * (config.maxSteps + 1) + GemBoard::CELLS);
+
+    std::vector<Node> beam;
+    beam.reserve(config.beamWidth);
+    for (int i = 0; i < GemBoard::CELLS; ++i) {
+        Node n;
+        n.board = board;
+        n.hash = hashBoard(board, i);
+        n.path.startCell = quint8(i);
+        n.path.length = 0;
+        n.order = quint32(i);
+        n.score = 0;
+        n.comboCount = n.clearedCells = n.damage = 0;
+        if (table.insert(n.hash)) beam.push_back(n);
+    }
+
+    std::vector<std::vector<Node>> local(config.threads);
+    std::vector<qint64> deduped(config.threads);
+    std::vector<Node> children;
+    QSemaphore layerDone;
+
+    for (int depth = 1; depth <= config.maxSteps; ++depth) {
+        if (timer.elapsed() >= config.timeBudgetMs) break;
+        if (generation && generation->load() != token) break;
+
+        // (2) 平行展開：每條 thread 以 atomic index 搶 parent
+        std::atomic<int> nextParent(0);
+        const std::function<void(int)> expand = [&](int worker) {
+            std::vector<Node> &out = local[worker];
+            out.clear();
+            for (int p = nextParent++; p < int(beam.size()); p = nextParent++) {
+                const Node &parent = beam[p];
+                const int from = parent.path.cellAt(parent.path.length);
+                const int r = BitBoard::rowOf(from);
+                const int c = BitBoard::colOf(from);
+                const int back = parent.path.length ? OPPOSITE[parent.path.steps[parent.path.length - 1]] : -1;
+
+                for (int d = 0; d < 4; ++d) {
+                    if (d == back) continue;
+                    const int nr = r + DR[d];
+                    const int nc = c + DC[d];
+                    if (nr < 0 || nr >= GemBoard::ROWS || nc < 0 || nc >= GemBoard::COLS) continue;
+                    const int to = nr * GemBoard::COLS + nc;
+
+                    // 交換只影響兩格內容與手上位置，hash 增量更新
+                    const int a = contentOf(parent.board.cell(from));
+                    const int b = contentOf(parent.board.cell(to));
+                    const quint64 h = parent.hash
+                        ^ z.gem[from][a] ^ z.gem[from][b]
+                        ^ z.gem[to][b]   ^ z.gem[to][a]
+                        ^ z.held[from]   ^ z.held[to];
+                    if (table.contains(h)) {
+                        ++deduped[worker];
+                        continue;
+                    }
+
+                    out.push_back(parent);
+                    Node &n = out.back();
+                    n.board.swap(r, c, nr, nc);
+                    n.hash = h;
+                    n.path.steps[n.path.length++] = quint8(d);
+                    n.order = quint32(p) * 4 + quint32(d);
+                    evaluate(n.board, attackers, n.comboCount, n.clearedCells, n.damage);
+                    n.score = scoreOf(attackers, n.comboCount, n.clearedCells, n.damage);
+                }
+            }
+        };
+
+        // 呼叫端自己也展開；helper 排隊較晚時只會發現 parent 已被搶完
+        const int helpers = qMin(config.threads, int(beam.size())) - 1;
+        for (int w = 1; w <= helpers; ++w) {
+            solverPool().start(new ExpandTask(expand, w, layerDone));
+        }
+        expand(0);
+        layerDone.acquire(helpers);
+
+        children.clear();
+        for (int w = 0; w <= helpers; ++w) {
+            children.insert(children.end(), local[w].begin(), local[w].end());
+        }
+        if (children.empty()) break;
+        result.statesExpanded += qint64(children.size());
+
+        // (3) 分數高的優先；同分以展開順序排，結果與 thread 數無關
+        std::sort(children.begin(), children.end(), [](const Node &x, const Node &y) {
+            if (x.score != y.score) return x.score > y.score;
+            return x.order < y.order;
+        });
+
+        beam.clear();
+        for (const Node &n : children) {
+            if (int(beam.size()) >= config.beamWidth) break;
+            if (!table.insert(n.hash)) {
+                ++result.statesDeduped;
+                continue;
+            }
+            beam.push_back(n);
+        }
+        if (beam.empty()) break;
+        result.depthReached = depth;
+
+        const Node &top = beam.front();
+        if (top.score > bestScore) {
+            bestScore = top.score;
+            result.path = top.path;
+            result.comboCount = top.comboCount;
+            result.clearedCells = top.clearedCells;
+            result.damage = top.damage;
+            result.boardAfter = top.board;
+        }
+    }
+
+    for (qint64 d : deduped) {
+        result.statesDeduped += d;
+    }
+    result.elapsedMs = timer.elapsed();
+    return result;
+}
@@ -0,0 +1,97 @@
+// DragSolver.h
+#pragma once
+
+#include <QAtomicInt>
+#include <QtGlobal>
+#include "GemBoard.h"
+
+class Combatants;
+
+/*
+ * DragSolver
+ *  - 轉珠是「拿起一顆符石沿路徑拖動」，每走一步就和相鄰格交換一次
+ *  - 以 beam search 搜尋拖動路徑：每一層把所有候選各往 3 個方向展開，
+ *    保留分數最高的 beamWidth 個；展開工作平均分給多條 thread
+ *    (DragSolver 專用的 QThreadPool，thread 在各層、各次 solve() 之間重複使用)
+ *  - 以 Zobrist hash (盤面 + 手上符石位置) 配合 lock-free 置換表去除重複狀態，
+ *    先走到的 (步數較少) 保留，之後重複的直接丟掉
+ *  - 評分只看「不補新」的結果：消除 → 下落 → 再判定，直到盤面穩定；
+ *    補新是隨機的，不應影響路徑選擇
+ *  - combo 優先；有 Attackers 時同 combo 比 Damage::teamDamage() 算出的實際傷害，
+ *    沒有時比消除格數
+ *  - 有時間預算，超過就回傳目前最好的路徑，保證在 10 秒轉珠倒數內給出答案
+ */
+class DragSolver
+{
+public:
+    enum Direction : quint8 { Up = 0, Down, Left, Right };
+
+    // 路徑長度上限 (也是 Config::maxSteps 的上限)
+    static constexpr int MAX_PATH = 48;
+
+    struct Config
+    {
+        int maxSteps;       // 最多拖幾步
+        int beamWidth;      // 每層保留幾個候選
+        int threads;        // 0 = 使用所有核心
+        int timeBudgetMs;   // 超過就停止搜尋
+
+        Config();
+    };
+
+    // 傷害評分用的攻擊方：party 的 [begin, end) 打屬性為 defender 的目標
+    //    party 為 nullptr (預設) 時不算傷害
+    struct Attackers
+    {
+        const Combatants *party;
+        int               begin;
+        int               end;
+        int               defender;     // Damage::NO_DEFENDER：不算相剋
+
+        Attackers();
+        Attackers(const Combatants &party, int begin, int end, int defender);
+    };
+
+    struct Path
+    {
+        quint8 startCell;           // 拿起的格子 (r * COLS + c)
+        quint8 length;              // 步數
+        quint8 steps[MAX_PATH];     // Direction
+
+        // 第 step 步之後手上符石所在的格子 (step = 0 為起點)
+        int cellAt(int step) const;
+    };
+
+    struct Result
+    {
+        Path     path;
+        int      comboCount;        // 含 cascade (不補新)
+        int      clearedCells;      // 消除格數總和 (含 cascade)
+        int      damage;            // Damage::Result::total (沒有 Attackers 時為 0)
+        GemBoard boardAfter;        // 拖完之後、消除之前的盤面
+        qint64   statesExpanded;
+        qint64   statesDeduped;     // 被置換表擋下的重複狀態
+        int      depthReached;
+        qint64   elapsedMs;
+    };
+
+    explicit DragSolver(const Config &config = Config());
+
+    // generation 不等於 token 時在下一層開始前停止 (給背景計算作廢用)
+    Result solve(const GemBoard &board, const Attackers &attackers = Attackers(),
+                 const QAtomicInt *generation = nullptr, int token = 0) const;
+
+    // 一個盤面「不補新」解完 cascade 的 combo 數、消除格數與傷害
+    static void evaluate(const GemBoard &board, const Attackers &attackers,
+                         int &comboCount, int &clearedCells, int &damage);
+    static void evaluate(const GemBoard &board, int &comboCount, int &clearedCells);
+
+    // 把路徑套到盤面上 (回傳拖完的盤面)
+    static GemBoard applyPath(const GemBoard &board, const Path &path);
+
+    // 路徑上每一步的相鄰交換；r1/c1 為拖動前位置，r2/c2 為拖動後位置
+    static void stepCells(const Path &path, int step, int &r1, int &c1, int &r2, int &c2);
+
+private:
+    Config config;
+};
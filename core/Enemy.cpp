@@ -0,0 +1,61 @@
+#include "Enemy.h"
+
+Enemy::Enemy()
+{
+}
+
+// 建構子
+Enemy::Enemy(int id,
+             Attribute attr,
+             int maxHP,
+             const QString &iconPath,
+             int cooldownDefault)
+    : Character(std::make_shared<Combatants>(), 0, id, iconPath)
+{
+    unitData->add(maxHP, 1, attr, cooldownDefault);
+}
+
+Enemy::Enemy(const std::shared_ptr<Combatants> &units, int index,
+             int id, const QString &iconPath)
+    : Character(units, index, id, iconPath)
+{
+}
+
+// ★ 在這裡才真正實作一次 virtual destructor ★
+Enemy::~Enemy()
+{
+
+}
+
+void Enemy::onNewTurn(Character &target)
+{
+    const int cooldown = unitData->cooldown(index) - 1;
+    if (cooldown <= 0) {
+        performAttack(target);
+        unitData->setCooldown(index, unitData->cooldownDefault(index));
+    } else {
+        unitData->setCooldown(index, cooldown);
+    }
+}
+
+void Enemy::performAttack(Character &target)
+{
+    if (target.isAlive()) {
+        target.takeDamage(getAttackPower());
+    }
+}
+
+int Enemy::getCooldownCounter() const
+{
+    return unitData->cooldown(index);
+}
+
+int Enemy::getCooldownDefault() const
+{
+    return unitData->cooldownDefault(index);
+}
+
+void Enemy::reset()
+{
+    unitData->revive(index, index + 1);
+}
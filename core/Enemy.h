@@ -2,23 +2,26 @@
 
 #include "Character.h"
 
+// 敵人的 handle：cooldown 也存在 Combatants 裡
 class Enemy : public Character
 {
 public:
+    Enemy();
+
     Enemy(int id,
           Attribute attr,
           int maxHP,
           const QString &iconPath,
           int cooldownDefault);
 
+    // 指向既有 Combatants 的第 index 格 (GameEngine 產生波次時使用)
+    Enemy(const std::shared_ptr<Combatants> &units, int index,
+          int id, const QString &iconPath);
+
     virtual ~Enemy();
     void onNewTurn(Character &target);
     void performAttack(Character &target);
     int getCooldownCounter() const;
     int getCooldownDefault() const;
     void reset() override;
-
-private:
-    int cooldownCounter;
-    int cooldownDefault;
 };
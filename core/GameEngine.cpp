@@ -0,0 +1,579 @@
+// GameEngine.cpp
+#include "GameEngine.h"
+#include "Trace.h"
+#include <QRandomGenerator>
+#include <QDebug>
+#include <algorithm>
+
+GameEngine::GameEngine()
+    : missionSeed(QRandomGenerator::global()->generate()),
+      turnIndex(0),
+      missionTable(nullptr),
+      missionDef(nullptr),
+      partyUnits(std::make_shared<Combatants>()),
+      enemyUnits(std::make_shared<Combatants>()),
+      currentWaveIndex(0),
+      missionID(0),
+      currentPhase(Idle),
+      profiling(false),
+      phaseTimes()
+{
+    match = BitBoard::MatchResult();
+    lastCascade.roundCount = 0;
+    lastCascade.comboCount = 0;
+    lastCascade.damage.total = 0;
+    lastCascade.damage.unitCount = 0;
+    seedTurn();
+}
+
+GameEngine::~GameEngine()
+{
+    // players 由外部管理；handle 的數值由 shared_ptr 保持，不需要回頭碰 players
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// setSeed() / seedTurn(): mission 種子；每回合的亂數由「種子 + 回合數」決定
+////////////////////////////////////////////////////////////////////////////////
+void GameEngine::setSeed(quint32 seed)
+{
+    missionSeed = seed;
+    seedTurn();
+}
+
+quint32 GameEngine::seed() const
+{
+    return missionSeed;
+}
+
+void GameEngine::seedTurn()
+{
+    // 回合數先乘上黃金比例常數打散，避免相鄰回合得到相近的種子
+    rng.seed(missionSeed ^ (quint32(turnIndex) * 0x9e3779b9u));
+}
+
+void GameEngine::setMissionTable(const MissionTable *table)
+{
+    missionTable = table;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// init(): 傳入玩家 Character* 陣列、missionID
+//    createParty() 的隊伍本來就共用一份 Combatants，直接接手；
+//    其他情況把每個角色的數值搬進新的一份 (空格放一個 0 HP 的單位，index 才對得上)
+////////////////////////////////////////////////////////////////////////////////
+void GameEngine::init(const QVector<Character*> &playerChars, int missionID)
+{
+    players = playerChars;
+
+    std::shared_ptr<Combatants> units = players.isEmpty() || !players[0]
+                                      ? nullptr : players[0]->units();
+    bool adopt = units && units->size() == players.size();
+    for (int i = 0; adopt && i < players.size(); ++i) {
+        adopt = players[i] && players[i]->units() == units && players[i]->unitIndex() == i;
+    }
+    if (adopt) {
+        partyUnits = units;
+    } else {
+        partyUnits = std::make_shared<Combatants>();
+        partyUnits->reserve(players.size());
+        for (Character *p : players) {
+            if (p) p->bindTo(partyUnits);
+            else   partyUnits->add(0, 0, 0, 0);
+        }
+    }
+
+    this->missionID = missionID;
+    turnIndex = 0;
+    currentWaveIndex = 0;
+    currentPhase = Idle;
+    match = BitBoard::MatchResult();
+    lastCascade.roundCount = 0;
+    lastCascade.comboCount = 0;
+    lastCascade.damage.total = 0;
+    lastCascade.damage.unitCount = 0;
+
+    // 清空舊盤面
+    gemBoard.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// startMission(): 根據 missionID 先產生波次，再產生 board，進入玩家回合
+////////////////////////////////////////////////////////////////////////////////
+void GameEngine::startMission()
+{
+    generateWavesFromMissionID(missionID);
+    turnIndex = 0;
+    seedTurn();
+    generateInitialGems();
+    currentWaveIndex = 0;
+    currentPhase = waveCount() == 0 ? Won : PlayerMove;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// swapGems() / endMove(): 玩家操作
+////////////////////////////////////////////////////////////////////////////////
+bool GameEngine::swapGems(int r1, int c1, int r2, int c2)
+{
+    if (currentPhase != PlayerMove) return false;
+    gemBoard.swap(r1, c1, r2, c2);
+    return true;
+}
+
+void GameEngine::endMove()
+{
+    if (currentPhase == PlayerMove) {
+        ++turnIndex;
+        seedTurn();
+        currentPhase = Matching;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// step(): 依目前 phase 推進一個階段
+////////////////////////////////////////////////////////////////////////////////
+GameEngine::StepResult GameEngine::step()
+{
+    switch (currentPhase) {
+        case Matching:       return stepMatching();
+        case Clearing:       return stepClearing();
+        case EnemyTurn:      return stepEnemyTurn();
+        case WaveTransition: return stepWaveTransition();
+        case Idle:
+        case PlayerMove:
+        case Won:
+        case Lost:
+            break;
+    }
+    return result(None);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// stepMatching(): 找出所有連線；沒有消除就直接輪到敵人
+////////////////////////////////////////////////////////////////////////////////
+GameEngine::StepResult GameEngine::stepMatching()
+{
+    TOS_TRACE_SCOPE("GameEngine::findMatches");
+    const qint64 t0 = profileStart();
+    BitBoard::findMatches(gemBoard.planes(), match);
+    profileEnd(phaseTimes.match, t0);
+    if (match.matched) {
+        currentPhase = Clearing;
+        return result(MatchesFound, match.matched, match.comboCount);
+    }
+
+    currentPhase = EnemyTurn;
+    return result(None);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// stepClearing(): 同步解完整串 cascade，結算傷害並打在敵人身上
+//    每一輪：清除 matched 格子 → 下落補新 → 記錄盤面 → 重新判定，直到沒有連線
+////////////////////////////////////////////////////////////////////////////////
+GameEngine::StepResult GameEngine::stepClearing()
+{
+    TOS_TRACE_SCOPE("GameEngine::resolveCascade");
+    Cascade &cas = lastCascade;
+    cas.roundCount = 0;
+    cas.comboCount = 0;
+    for (int &count : cas.clearedCount) count = 0;
+
+    BitBoard::Mask allCleared = 0;
+    for (;;) {
+        CascadeRound &round = cas.rounds[cas.roundCount++];
+        round.cleared = match.matched;
+        round.comboCount = match.comboCount;
+
+        for (int a = 0; a < BitBoard::ATTR_COUNT; ++a) {
+            cas.clearedCount[a] += BitBoard::count(match.attrMatched[a]);
+        }
+        cas.comboCount += match.comboCount;
+        allCleared |= match.matched;
+
+        clearCells(match.matched);
+        applyGravityAndRefill();
+        round.boardAfter = gemBoard;
+
+        if (cas.roundCount >= MAX_CASCADE_ROUNDS) break;
+        const qint64 t0 = profileStart();
+        BitBoard::findMatches(gemBoard.planes(), match);
+        profileEnd(phaseTimes.match, t0);
+        if (!match.matched) break;
+    }
+
+    // 全隊的傷害依第一隻還活著的敵人的屬性結算，打在牠身上
+    const int target = enemyUnits->firstAlive(waveBegin(currentWaveIndex), waveEnd(currentWaveIndex));
+    Damage::Input in;
+    std::copy(cas.clearedCount, cas.clearedCount + BitBoard::ATTR_COUNT, in.clearedCount);
+    in.comboCount = cas.comboCount;
+    in.defender = target >= 0 ? enemyUnits->attribute(target) : Damage::NO_DEFENDER;
+    Damage::teamDamage(*partyUnits, 0, partyUnits->size(), in, cas.damage);
+
+    const int totalDamage = cas.damage.total;
+    if (target >= 0) {
+        enemyUnits->damage(target, totalDamage);
+    }
+
+    currentPhase = areEnemiesAllDead() ? WaveTransition : EnemyTurn;
+    return result(DamageDealt, allCleared, cas.comboCount, totalDamage);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// stepEnemyTurn(): 本波活著的敵人輪流攻擊，每一下打在第一個活著的角色 (溢出的傷害不延續)
+//    沒有角色會倒下時只需要一次敵人攻擊力加總 (見 Combatants::takeHits())
+////////////////////////////////////////////////////////////////////////////////
+GameEngine::StepResult GameEngine::stepEnemyTurn()
+{
+    TOS_TRACE_SCOPE("GameEngine::enemyTurn");
+    if (currentWaveIndex >= waveCount()) {
+        currentPhase = Won;
+        return result(GameWon);
+    }
+
+    const qint64 t0 = profileStart();
+    const int totalDamage = partyUnits->takeHits(0, partyUnits->size(), *enemyUnits,
+                                                 waveBegin(currentWaveIndex), waveEnd(currentWaveIndex));
+    profileEnd(phaseTimes.enemy, t0);
+
+    if (arePlayersAllDead()) {
+        currentPhase = Lost;
+        return result(GameLost, 0, 0, totalDamage);
+    }
+
+    currentPhase = PlayerMove;
+    return result(EnemyAttacked, 0, 0, totalDamage);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// stepWaveTransition(): 進入下一波；三波都打完就勝利
+////////////////////////////////////////////////////////////////////////////////
+GameEngine::StepResult GameEngine::stepWaveTransition()
+{
+    TOS_TRACE_SCOPE("GameEngine::waveTransition");
+    currentWaveIndex++;
+    if (currentWaveIndex >= waveCount()) {
+        currentPhase = Won;
+        return result(GameWon);
+    }
+
+    generateInitialGems();
+    currentPhase = PlayerMove;
+    return result(WaveCleared, BitBoard::FULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// snapshot() / restore(): 玩家回合開始時的狀態 (給重播檔的 keyframe 使用)
+//    已打完的波次敵人全滅、之後的波次滿血，只需記錄目前這一波
+////////////////////////////////////////////////////////////////////////////////
+GameEngine::Snapshot GameEngine::snapshot() const
+{
+    Snapshot s = Snapshot();
+    s.turn = turnIndex;
+    s.wave = currentWaveIndex;
+    s.board = gemBoard;
+
+    s.playerCount = qMin(partyUnits->size(), int(MAX_SNAPSHOT_PLAYERS));
+    for (int i = 0; i < s.playerCount; ++i) {
+        s.playerHP[i] = partyUnits->hp(i);
+    }
+
+    const int begin = waveBegin(currentWaveIndex);
+    s.enemyCount = waveEnd(currentWaveIndex) - begin;
+    s.enemyHP.resize(s.enemyCount);
+    for (int i = 0; i < s.enemyCount; ++i) {
+        s.enemyHP[i] = enemyUnits->hp(begin + i);
+    }
+    return s;
+}
+
+bool GameEngine::restore(const Snapshot &s)
+{
+    if (s.wave < 0 || s.wave >= waveCount()) return false;
+    if (s.playerCount != partyUnits->size() ||
+        s.enemyCount != waveEnd(s.wave) - waveBegin(s.wave) ||
+        s.enemyHP.size() < s.enemyCount)
+    {
+        return false;
+    }
+
+    for (int i = 0; i < s.playerCount; ++i) {
+        partyUnits->setHP(i, s.playerHP[i]);
+    }
+
+    // 之前的波次全滅、這一波照 snapshot、之後的波次滿血
+    const int begin = waveBegin(s.wave);
+    enemyUnits->kill(0, begin);
+    for (int i = 0; i < s.enemyCount; ++i) {
+        enemyUnits->setHP(begin + i, s.enemyHP[i]);
+    }
+    enemyUnits->revive(waveEnd(s.wave), enemyUnits->size());
+
+    turnIndex = s.turn;
+    seedTurn();
+    gemBoard = s.board;
+    currentWaveIndex = s.wave;
+    match = BitBoard::MatchResult();
+    lastCascade.roundCount = 0;
+    lastCascade.comboCount = 0;
+    lastCascade.damage.total = 0;
+    lastCascade.damage.unitCount = 0;
+    currentPhase = PlayerMove;
+    return true;
+}
+
+GameEngine::StepResult GameEngine::result(Event e, BitBoard::Mask cells,
+                                          int comboCount, int damage)
+{
+    StepResult r;
+    r.event = e;
+    r.cells = cells;
+    r.comboCount = comboCount;
+    r.damage = damage;
+    return r;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Getter
+////////////////////////////////////////////////////////////////////////////////
+GameEngine::Phase GameEngine::phase() const
+{
+    return currentPhase;
+}
+
+const GemBoard &GameEngine::board() const
+{
+    return gemBoard;
+}
+
+const BitBoard::MatchResult &GameEngine::lastMatch() const
+{
+    return match;
+}
+
+const GameEngine::Cascade &GameEngine::cascade() const
+{
+    return lastCascade;
+}
+
+Damage::Result GameEngine::estimateDamage(const int (&clearedCount)[BitBoard::ATTR_COUNT],
+                                          int comboCount) const
+{
+    Damage::Input in;
+    std::copy(clearedCount, clearedCount + BitBoard::ATTR_COUNT, in.clearedCount);
+    in.comboCount = comboCount;
+    in.defender = currentDefender();
+
+    Damage::Result out;
+    Damage::teamDamage(*partyUnits, 0, partyUnits->size(), in, out);
+    return out;
+}
+
+const Combatants &GameEngine::partyCombatants() const
+{
+    return *partyUnits;
+}
+
+int GameEngine::currentDefender() const
+{
+    const int target = enemyUnits->firstAlive(waveBegin(currentWaveIndex), waveEnd(currentWaveIndex));
+    return target >= 0 ? enemyUnits->attribute(target) : Damage::NO_DEFENDER;
+}
+
+int GameEngine::missionId() const
+{
+    return missionID;
+}
+
+int GameEngine::turn() const
+{
+    return turnIndex;
+}
+
+int GameEngine::currentWave() const
+{
+    return currentWaveIndex;
+}
+
+int GameEngine::waveCount() const
+{
+    return qMax(0, waveStart.size() - 1);
+}
+
+int GameEngine::waveBegin(int wave) const
+{
+    return (wave >= 0 && wave < waveCount()) ? waveStart[wave] : 0;
+}
+
+int GameEngine::waveEnd(int wave) const
+{
+    return (wave >= 0 && wave < waveCount()) ? waveStart[wave + 1] : 0;
+}
+
+// 指向 enemyHandles 的指標，下一次 startMission() 前有效
+QVector<Enemy*> GameEngine::currentWaveEnemies() const
+{
+    return waveEnemies(currentWaveIndex);
+}
+
+QVector<Enemy*> GameEngine::waveEnemies(int wave) const
+{
+    QVector<Enemy*> enemies;
+    if (wave < 0 || wave >= waveCount()) return enemies;
+    const int begin = waveBegin(wave);
+    const int end = waveEnd(wave);
+    enemies.reserve(end - begin);
+    for (int i = begin; i < end; ++i) {
+        enemies.append(&enemyHandles[i]);
+    }
+    return enemies;
+}
+
+const QVector<Character*> &GameEngine::playerCharacters() const
+{
+    return players;
+}
+
+bool GameEngine::arePlayersAllDead() const
+{
+    return !partyUnits->anyAlive(0, partyUnits->size());
+}
+
+bool GameEngine::areEnemiesAllDead() const
+{
+    return !enemyUnits->anyAlive(waveBegin(currentWaveIndex), waveEnd(currentWaveIndex));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// generateWavesFromMissionID(): 依 MissionTable 的定義產生各波敵人
+//    敵人數值依波次接在 enemyUnits 後面；handle 的圖示路徑是表裡共用的 QString，不另外組字串
+////////////////////////////////////////////////////////////////////////////////
+void GameEngine::generateWavesFromMissionID(int missionID)
+{
+    clearWaves();
+
+    const MissionTable &table = missionTable ? *missionTable : MissionTable::shared();
+    missionDef = table.mission(missionID);
+    if (!missionDef) {
+        qWarning() << "[GameEngine] Unknown missionID =" << missionID;
+        return;
+    }
+
+    int total = 0;
+    for (int w = 0; w < missionDef->waveCount; ++w) {
+        total += table.wave(*missionDef, w).enemyCount;
+    }
+    enemyUnits->reserve(total);
+    enemyHandles.reserve(total);
+    waveStart.reserve(missionDef->waveCount + 1);
+
+    waveStart.append(0);
+    for (int w = 0; w < missionDef->waveCount; ++w) {
+        const MissionTable::WaveDef &def = table.wave(*missionDef, w);
+        for (int i = 0; i < def.enemyCount; ++i) {
+            const MissionTable::EnemyDef &e = table.enemy(def, i);
+            const int index = enemyUnits->add(int(e.maxHP), e.attack, e.attribute, e.cooldown);
+            enemyHandles.append(Enemy(enemyUnits, index, e.id, table.iconPath(e)));
+        }
+        waveStart.append(enemyUnits->size());
+    }
+}
+
+// 清空但保留容量，下一個 mission 重複使用
+void GameEngine::clearWaves()
+{
+    enemyUnits->clear();
+    enemyHandles.resize(0);
+    waveStart.resize(0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// randomGem(): 隨機產生一顆一般符石
+////////////////////////////////////////////////////////////////////////////////
+Gem GameEngine::randomGem()
+{
+    // 依 mission 的掉落權重抽屬性；權重全為 1 時與 bounded(ATTR_COUNT) 的結果相同
+    int rnd;
+    if (missionDef) {
+        rnd = missionDef->dropAttribute(rng.bounded(int(missionDef->dropTotal)));
+    } else {
+        rnd = rng.bounded(BitBoard::ATTR_COUNT);
+    }
+    return Gem::make(static_cast<Gem::Attribute>(rnd));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// generateInitialGems(): 隨機把 board 每一格填滿新 Gem
+////////////////////////////////////////////////////////////////////////////////
+void GameEngine::generateInitialGems()
+{
+    for (int i = 0; i < GemBoard::CELLS; ++i) {
+        gemBoard.cell(i) = randomGem();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// loadBoard(): 直接指定盤面內容
+////////////////////////////////////////////////////////////////////////////////
+void GameEngine::loadBoard(const GemBoard &board)
+{
+    gemBoard = board;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// clearCells(): 把指定格子清成空格
+////////////////////////////////////////////////////////////////////////////////
+void GameEngine::clearCells(BitBoard::Mask cells)
+{
+    TOS_TRACE_SCOPE("GameEngine::clearCells");
+    while (cells) {
+        gemBoard.cell(BitBoard::lowestIndex(cells)) = Gem::empty();
+        cells &= cells - 1;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// applyGravityAndRefill(): 消除完成後，下落並補新
+////////////////////////////////////////////////////////////////////////////////
+void GameEngine::applyGravityAndRefill()
+{
+    TOS_TRACE_SCOPE("GameEngine::applyGravityAndRefill");
+    const qint64 t0 = profileStart();
+    BitBoard::Mask holes = gemBoard.collapse();
+    profileEnd(phaseTimes.gravity, t0);
+
+    const qint64 t1 = profileStart();
+    while (holes) {
+        gemBoard.cell(BitBoard::lowestIndex(holes)) = randomGem();
+        holes &= holes - 1;
+    }
+    profileEnd(phaseTimes.refill, t1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// setProfiling() / takePhaseTimes(): 給效能 HUD 用的各階段耗時
+////////////////////////////////////////////////////////////////////////////////
+void GameEngine::setProfiling(bool enabled)
+{
+    if (enabled && !profileClock.isValid()) {
+        profileClock.start();
+    }
+    profiling = enabled;
+}
+
+GameEngine::PhaseTimes GameEngine::takePhaseTimes()
+{
+    const PhaseTimes t = phaseTimes;
+    phaseTimes = PhaseTimes();
+    return t;
+}
+
+qint64 GameEngine::profileStart() const
+{
+    return profiling ? profileClock.nsecsElapsed() : 0;
+}
+
+void GameEngine::profileEnd(qint64 &slot, qint64 start) const
+{
+    if (profiling) {
+        slot += profileClock.nsecsElapsed() - start;
+    }
+}
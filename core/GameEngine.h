@@ -0,0 +1,216 @@
+// GameEngine.h
+#pragma once
+
+#include <QVector>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include "GemBoard.h"
+#include "Character.h"
+#include "Damage.h"
+#include "Enemy.h"
+#include "MissionTable.h"
+
+/*
+ * GameEngine
+ *  - 不依賴 QtWidgets / QtGui / QTimer / event loop 的遊戲規則核心
+ *  - 盤面、消除判定、下落補新、波次、戰鬥與回合狀態機都在這裡
+ *  - 由外部明確呼叫 step() 推進一個階段；GUI 的 GameController 只是其中一個 client，
+ *    工具、測試、批次模擬可以直接以全速呼叫
+ *
+ * 回合流程 (Phase)：
+ *   PlayerMove ──endMove()──▶ Matching ──step()──▶ Clearing (有消除) ──step()──▶ EnemyTurn / WaveTransition
+ *                                          └────▶ EnemyTurn (無消除)
+ *   EnemyTurn      ──step()──▶ PlayerMove / Lost
+ *   WaveTransition ──step()──▶ PlayerMove (下一波) / Won
+ *
+ * 亂數：每局一個 mission 種子，每個玩家回合 (endMove()) 再由「種子 + 回合數」重新設定，
+ * 所以只要知道種子與回合數就能重現該回合的所有補新，不必從頭模擬。
+ *
+ * Clearing 一次 step() 就同步解完整串 cascade (消除 → 下落補新 → 再判定 … 直到盤面穩定)，
+ * 過程記錄在 cascade() 的步驟列表裡，UI 只需照著播放，不必每一輪再回頭問 engine。
+ *
+ * 波次、敵人數值與補珠權重來自 MissionTable (預設為 MissionTable::shared())。
+ *
+ * 戰鬥數值以 Combatants (structure-of-arrays) 存放：隊伍一份、整個 mission 的敵人一份
+ * (各波連續排列)。敵人回合與傷害結算直接對陣列區間做迴圈；Character / Enemy 只是 handle。
+ *
+ * 消除的傷害由 Damage::teamDamage() 結算：各屬性消除格數 × combo 倍率 × 角色攻擊力 ×
+ * 對目標 (本波第一隻活著的敵人) 的屬性相剋倍率。
+ */
+class GameEngine
+{
+public:
+    enum Phase {
+        Idle = 0,        // 尚未開始
+        PlayerMove,      // 玩家轉珠中
+        Matching,        // 轉珠結束，等待判定
+        Clearing,        // 已找到消除，等待解完整串 cascade
+        EnemyTurn,       // 敵人攻擊
+        WaveTransition,  // 本波敵人全滅，等待進入下一波
+        Won,
+        Lost
+    };
+
+    enum Event {
+        None = 0,
+        MatchesFound,    // cells / comboCount 有效
+        DamageDealt,     // cells (全部消除格) / comboCount (含 cascade) / damage 有效
+        EnemyAttacked,   // damage 為敵人造成的總傷害
+        WaveCleared,     // 已切到下一波並重新產生盤面
+        GameWon,
+        GameLost
+    };
+
+    struct StepResult
+    {
+        Event          event;
+        BitBoard::Mask cells;       // 本階段涉及的格子
+        int            comboCount;
+        int            damage;
+    };
+
+    // cascade 最多記錄的輪數；超過時剩下的連線留到下一回合
+    static constexpr int MAX_CASCADE_ROUNDS = 16;
+
+    // cascade 的一輪：先消除 cleared，再下落補新成 boardAfter
+    struct CascadeRound
+    {
+        BitBoard::Mask cleared;
+        int            comboCount;
+        GemBoard       boardAfter;
+    };
+
+    // 一次 Clearing 的完整步驟列表 (固定大小，不做 heap 配置)
+    struct Cascade
+    {
+        int          roundCount;
+        int          comboCount;                        // 所有輪的 combo 總數
+        int          clearedCount[BitBoard::ATTR_COUNT]; // 各屬性消除格數
+        Damage::Result damage;                          // 全隊傷害與每個角色的分項
+        CascadeRound rounds[MAX_CASCADE_ROUNDS];
+    };
+
+    // snapshot 最多記錄的玩家角色數 (隊伍 6 格)；一波敵人的數量不限
+    static constexpr int MAX_SNAPSHOT_PLAYERS = 8;
+    static_assert(MAX_SNAPSHOT_PLAYERS <= Damage::MAX_TEAM, "per-unit damage must cover the party");
+
+    // 玩家回合開始時的完整狀態；每回合的亂數只由種子 + 回合數決定，不需要存亂數狀態
+    struct Snapshot
+    {
+        int      turn;
+        int      wave;
+        GemBoard board;
+        int      playerCount;
+        int      playerHP[MAX_SNAPSHOT_PLAYERS];
+        int      enemyCount;
+        QVector<int> enemyHP;
+    };
+
+    // 各階段累計耗時 (奈秒)；只在 setProfiling(true) 時量測
+    struct PhaseTimes
+    {
+        qint64 match;       // 連線判定 (含 cascade 每一輪)
+        qint64 gravity;     // 下落
+        qint64 refill;      // 補新
+        qint64 enemy;       // 敵人回合
+    };
+
+    GameEngine();
+    ~GameEngine();
+
+    // 設定 mission 種子 (同一個種子 + 同樣的操作 → 同樣的盤面與結果)
+    void setSeed(quint32 seed);
+    quint32 seed() const;
+
+    // 使用的 mission 定義表 (不接管所有權；nullptr = MissionTable::shared())
+    void setMissionTable(const MissionTable *table);
+
+    // 初始化：玩家角色 (不接管所有權) + missionID
+    void init(const QVector<Character*> &playerChars, int missionID);
+
+    // 產生波次與初始盤面，進入 PlayerMove
+    void startMission();
+
+    // 玩家轉珠 (僅在 PlayerMove 有效)
+    bool swapGems(int r1, int c1, int r2, int c2);
+
+    // 玩家轉珠結束 (倒數到、放開手指)
+    void endMove();
+
+    // 推進一個階段，回傳此階段產生的事件
+    StepResult step();
+
+    // 存下／還原玩家回合開始時的狀態 (restore 前需先 init() + startMission())
+    Snapshot snapshot() const;
+    bool     restore(const Snapshot &s);
+
+    // 量測各階段耗時 (預設關閉；關閉時每階段只多一次 bool 判斷)
+    void setProfiling(bool enabled);
+    // 取出上次取出後累計的耗時並歸零
+    PhaseTimes takePhaseTimes();
+
+    // 低階盤面操作 (不改變 phase；給工具、benchmark 使用)
+    void loadBoard(const GemBoard &board);
+    void generateInitialGems();
+    void clearCells(BitBoard::Mask cells);
+    void applyGravityAndRefill();
+
+    // Getter
+    Phase                  phase() const;
+    const GemBoard        &board() const;
+    const BitBoard::MatchResult &lastMatch() const;
+    const Cascade         &cascade() const;           // 最近一次 Clearing 的步驟列表
+    // 以目前隊伍與本波目標試算傷害 (轉珠預覽用；不改變任何狀態)
+    Damage::Result         estimateDamage(const int (&clearedCount)[BitBoard::ATTR_COUNT],
+                                          int comboCount) const;
+    const Combatants      &partyCombatants() const;   // 隊伍的數值 (DragSolver 算傷害用)
+    int                    currentDefender() const;   // 本波第一個活著的敵人屬性；沒有時 Damage::NO_DEFENDER
+    int                    missionId() const;
+    int                    turn() const;              // 已結束的玩家回合數
+    int                    currentWave() const;
+    int                    waveCount() const;
+    QVector<Enemy*>        currentWaveEnemies() const;
+    QVector<Enemy*>        waveEnemies(int wave) const;    // 超出範圍回傳空的
+    const QVector<Character*> &playerCharacters() const;
+    bool                   arePlayersAllDead() const;
+    bool                   areEnemiesAllDead() const;
+
+private:
+    Gem  randomGem();
+    void seedTurn();
+    void generateWavesFromMissionID(int missionID);
+    void clearWaves();
+    int  waveBegin(int wave) const;             // 第 wave 波在 enemyUnits 的範圍
+    int  waveEnd(int wave) const;
+
+    StepResult stepMatching();
+    StepResult stepClearing();
+    StepResult stepEnemyTurn();
+    StepResult stepWaveTransition();
+
+    static StepResult result(Event e, BitBoard::Mask cells = 0,
+                             int comboCount = 0, int damage = 0);
+
+    qint64 profileStart() const;
+    void   profileEnd(qint64 &slot, qint64 start) const;
+
+    QRandomGenerator         rng;               // 本回合的亂數產生器 (由 missionSeed + turnIndex 設定)
+    quint32                  missionSeed;
+    int                      turnIndex;
+    GemBoard                 gemBoard;          // 盤面 (ROWS × COLS)
+    BitBoard::MatchResult    match;             // 最近一次判定結果
+    Cascade                  lastCascade;       // 最近一次 Clearing 的 cascade
+    QVector<Character*>      players;           // 玩家角色指標 (外部管理刪除)
+    const MissionTable      *missionTable;      // nullptr = MissionTable::shared()
+    const MissionTable::MissionDef *missionDef; // 目前 mission 的定義 (補珠權重)
+    std::shared_ptr<Combatants> partyUnits;     // 隊伍數值 (與 players 的 handle 共用)
+    std::shared_ptr<Combatants> enemyUnits;     // 所有波次的敵人數值，依波次連續排列
+    QVector<int>             waveStart;         // 第 w 波為 [waveStart[w], waveStart[w + 1])
+    mutable QVector<Enemy>   enemyHandles;      // 每隻敵人一個 handle，currentWaveEnemies() 指向這裡
+    int                      currentWaveIndex;  // 目前波次
+    int                      missionID;
+    Phase                    currentPhase;
+    bool                     profiling;
+    QElapsedTimer            profileClock;
+    PhaseTimes               phaseTimes;
+};
@@ -0,0 +1,43 @@
+// Gem.cpp
+#include "Gem.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// 產生符石／空格
+////////////////////////////////////////////////////////////////////////////////
+
+Gem Gem::make(Attribute type, EffectStatus effect)
+{
+    Gem g;
+    g.type = quint8(type);
+    g.effectStatus = quint8(effect);
+    g.state = quint8(Idle);
+    g.flags = FlagOccupied;
+    return g;
+}
+
+Gem Gem::empty()
+{
+    Gem g;
+    g.type = 0;
+    g.effectStatus = quint8(Normal);
+    g.state = quint8(Idle);
+    g.flags = 0;
+    return g;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 狀態
+////////////////////////////////////////////////////////////////////////////////
+
+void Gem::markForClearing()
+{
+    flags |= FlagToBeCleared;
+    state = quint8(Clearing);
+}
+
+bool Gem::looksLike(const Gem &other) const
+{
+    if (isEmpty() || other.isEmpty())
+        return isEmpty() == other.isEmpty();
+    return type == other.type && effectStatus == other.effectStatus;
+}
@@ -0,0 +1,61 @@
+// Gem.h
+#pragma once
+
+#include <QtGlobal>
+#include <type_traits>
+
+/*
+ * Gem
+ *  - 盤面上一格符石的資料，只有 4 bytes 的 POD
+ *  - 屬性、附加效果、動畫狀態、旗標各佔 1 byte
+ *  - 圖資與畫面座標等繪製狀態放在 GemSprite，不跟著盤面資料搬動
+ */
+class Gem
+{
+public:
+    // 和 Character 共用的屬性枚舉
+    enum Attribute { Water = 0, Fire, Earth, Light, Dark };
+
+    // 敵人技能對符石的附加效果
+    enum EffectStatus { Normal = 0, Burning, Weathered };
+
+    // 動畫／狀態
+    enum State { Idle = 0, Swapping, Falling, Clearing };
+
+    // 每顆符石格子尺寸（像素）
+    static constexpr int TILE_SIZE = 90;
+
+    // 產生一顆符石／一個空格
+    static Gem make(Attribute type, EffectStatus effect = Normal);
+    static Gem empty();
+
+    // Getter
+    Attribute    getType() const         { return static_cast<Attribute>(type); }
+    EffectStatus getEffectStatus() const { return static_cast<EffectStatus>(effectStatus); }
+    State        getState() const        { return static_cast<State>(state); }
+    bool         isEmpty() const         { return (flags & FlagOccupied) == 0; }
+    bool         isToBeCleared() const   { return (flags & FlagToBeCleared) != 0; }
+
+    // Setter
+    void setType(Attribute t)            { type = quint8(t); }
+    void setEffectStatus(EffectStatus s) { effectStatus = quint8(s); }
+    void setState(State s)               { state = quint8(s); }
+    void markForClearing();              // 標記此顆符石為待清除
+
+    // 屬性與效果都相同 (畫面上看起來一樣)
+    bool looksLike(const Gem &other) const;
+
+private:
+    enum Flag : quint8 {
+        FlagOccupied    = 0x01,
+        FlagToBeCleared = 0x02
+    };
+
+    quint8 type;            // 符石屬性
+    quint8 effectStatus;    // 敵人技能附加效果
+    quint8 state;           // 符石當前狀態
+    quint8 flags;           // Flag 組合
+};
+
+static_assert(sizeof(Gem) == 4, "Gem must stay a 4-byte record");
+static_assert(std::is_trivial<Gem>::value, "Gem must stay a POD record");
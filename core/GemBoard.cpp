@@ -0,0 +1,75 @@
+// GemBoard.cpp
+#include "GemBoard.h"
+#include <algorithm>
+
+GemBoard::GemBoard()
+{
+    clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// clear(): 全部變成空格
+////////////////////////////////////////////////////////////////////////////////
+void GemBoard::clear()
+{
+    std::fill(cells, cells + CELLS, Gem::empty());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// swap(): 交換兩格的內容
+////////////////////////////////////////////////////////////////////////////////
+void GemBoard::swap(int r1, int c1, int r2, int c2)
+{
+    std::swap(at(r1, c1), at(r2, c2));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// planes(): 依屬性把格子轉成位元 plane
+////////////////////////////////////////////////////////////////////////////////
+BitBoard::Planes GemBoard::planes() const
+{
+    BitBoard::Planes p = {};
+    for (int i = 0; i < CELLS; ++i) {
+        const Gem &g = cells[i];
+        if (!g.isEmpty()) {
+            p.attr[g.getType()] |= BitBoard::Mask(1) << i;
+        }
+    }
+    return p;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// emptyMask(): 目前所有空格
+////////////////////////////////////////////////////////////////////////////////
+BitBoard::Mask GemBoard::emptyMask() const
+{
+    BitBoard::Mask m = 0;
+    for (int i = 0; i < CELLS; ++i) {
+        if (cells[i].isEmpty()) m |= BitBoard::Mask(1) << i;
+    }
+    return m;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// collapse(): 每一欄由下往上壓實，回傳上方剩下的空格
+////////////////////////////////////////////////////////////////////////////////
+BitBoard::Mask GemBoard::collapse()
+{
+    BitBoard::Mask holes = 0;
+    for (int c = 0; c < COLS; ++c) {
+        int writeRow = ROWS - 1;
+        for (int r = ROWS - 1; r >= 0; --r) {
+            if (!at(r, c).isEmpty()) {
+                if (r != writeRow) {
+                    at(writeRow, c) = at(r, c);
+                    at(r, c) = Gem::empty();
+                }
+                --writeRow;
+            }
+        }
+        for (int r = writeRow; r >= 0; --r) {
+            holes |= BitBoard::bit(r, c);
+        }
+    }
+    return holes;
+}
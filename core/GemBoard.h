@@ -0,0 +1,49 @@
+// GemBoard.h
+#pragma once
+
+#include "Gem.h"
+#include "BitBoard.h"
+
+/*
+ * GemBoard
+ *  - 5×6 盤面，以連續的 Gem 陣列 (row-major) 存放，容量固定
+ *  - 消除只是把格子標成空格，補新只是覆寫格子內容，都不會動到 allocator
+ *  - 格子 index 與 BitBoard 的位元順序一致 (r * COLS + c)
+ */
+class GemBoard
+{
+public:
+    static constexpr int ROWS  = BitBoard::ROWS;
+    static constexpr int COLS  = BitBoard::COLS;
+    static constexpr int CELLS = BitBoard::CELLS;
+
+    GemBoard();
+
+    // 全部變成空格
+    void clear();
+
+    // 取得／設定格子
+    const Gem &at(int r, int c) const { return cells[r * COLS + c]; }
+    Gem       &at(int r, int c)       { return cells[r * COLS + c]; }
+    const Gem &cell(int index) const  { return cells[index]; }
+    Gem       &cell(int index)        { return cells[index]; }
+
+    bool isEmpty(int r, int c) const  { return at(r, c).isEmpty(); }
+    void set(int r, int c, Gem g)     { at(r, c) = g; }
+    void remove(int r, int c)         { at(r, c) = Gem::empty(); }
+
+    // 交換兩格
+    void swap(int r1, int c1, int r2, int c2);
+
+    // 每種屬性一張位元 plane (給 BitBoard::findMatches 使用)
+    BitBoard::Planes planes() const;
+
+    // 目前所有空格
+    BitBoard::Mask emptyMask() const;
+
+    // 讓符石往下掉、填滿下方空格；回傳掉落後留在上方的空格
+    BitBoard::Mask collapse();
+
+private:
+    Gem cells[CELLS];
+};
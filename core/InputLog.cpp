@@ -0,0 +1,95 @@
+// InputLog.cpp
+#include "InputLog.h"
+
+namespace {
+
+// FNV-1a，逐 byte 累加
+inline void mix(quint64 &h, quint32 value)
+{
+    for (int i = 0; i < 4; ++i) {
+        h ^= (value >> (i * 8)) & 0xff;
+        h *= Q_UINT64_C(0x100000001b3);
+    }
+}
+
+} // namespace
+
+InputLog::InputLog()
+{
+    clear();
+}
+
+void InputLog::clear()
+{
+    seed = 0;
+    missionID = 0;
+    team.clear();
+    totalHP = 0;
+    inputs.clear();
+    finished = false;
+    outcome = Outcome();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// begin() / addSwap() / addEndMove() / finish(): 錄製
+////////////////////////////////////////////////////////////////////////////////
+void InputLog::begin(quint32 s, int mission, const QVector<int> &t, int hp)
+{
+    clear();
+    seed = s;
+    missionID = mission;
+    team = t;
+    totalHP = hp;
+}
+
+void InputLog::addSwap(quint32 tickMs, int r1, int c1, int r2, int c2)
+{
+    Input in;
+    in.tickMs = tickMs;
+    in.type = Swap;
+    in.r1 = quint8(r1); in.c1 = quint8(c1);
+    in.r2 = quint8(r2); in.c2 = quint8(c2);
+    inputs.append(in);
+}
+
+void InputLog::addEndMove(quint32 tickMs)
+{
+    Input in = Input();
+    in.tickMs = tickMs;
+    in.type = EndMove;
+    inputs.append(in);
+}
+
+void InputLog::finish(const GameEngine &engine)
+{
+    finished = true;
+    outcome.phase = quint8(engine.phase());
+    outcome.turns = engine.turn();
+    outcome.wave = engine.currentWave();
+    outcome.checksum = checksum(engine);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// checksum(): 盤面 + 回合 + 波次 + 雙方 HP
+////////////////////////////////////////////////////////////////////////////////
+quint64 InputLog::checksum(const GameEngine &engine)
+{
+    quint64 h = Q_UINT64_C(0xcbf29ce484222325);
+
+    const GemBoard &board = engine.board();
+    for (int i = 0; i < GemBoard::CELLS; ++i) {
+        const Gem &g = board.cell(i);
+        mix(h, g.isEmpty() ? 0xffu : (quint32(g.getType()) | quint32(g.getEffectStatus()) << 8));
+    }
+
+    mix(h, quint32(engine.phase()));
+    mix(h, quint32(engine.turn()));
+    mix(h, quint32(engine.currentWave()));
+    for (Character *p : engine.playerCharacters()) {
+        mix(h, quint32(p ? p->getCurrentHP() : 0));
+    }
+    for (Enemy *e : engine.currentWaveEnemies()) {
+        mix(h, quint32(e ? e->getCurrentHP() : 0));
+    }
+    return h;
+}
@@ -0,0 +1,59 @@
+// InputLog.h
+#pragma once
+
+#include <QVector>
+#include "GameEngine.h"
+
+/*
+ * InputLog
+ *  - 一局 mission 的完整輸入紀錄：mission 種子、隊伍、missionID，
+ *    以及玩家的每一次交換、每一次轉珠結束 (倒數到) 與發生的時間
+ *  - 規則核心是決定性的，只要把同樣的輸入依序餵給 GameEngine，結果就完全相同；
+ *    結束時的 checksum 讓重播可以確認是否一致
+ *  - 存檔格式見 ReplayFile.h
+ */
+class InputLog
+{
+public:
+    enum InputType : quint8 { Swap = 0, EndMove };
+
+    struct Input
+    {
+        quint32 tickMs;     // 距離 mission 開始的毫秒數
+        quint8  type;       // InputType
+        quint8  r1, c1, r2, c2;
+    };
+
+    // 結束時的狀態 (給重播比對)
+    struct Outcome
+    {
+        quint8  phase;      // GameEngine::Phase
+        int     turns;
+        int     wave;
+        quint64 checksum;
+    };
+
+    InputLog();
+
+    void clear();
+
+    // 開始一局：記下重現這局需要的設定
+    void begin(quint32 seed, int missionID, const QVector<int> &team, int totalHP);
+
+    void addSwap(quint32 tickMs, int r1, int c1, int r2, int c2);
+    void addEndMove(quint32 tickMs);
+
+    // 結束一局：記下結果
+    void finish(const GameEngine &engine);
+
+    // 引擎目前狀態的 64-bit 摘要 (盤面、回合、波次、雙方 HP)
+    static quint64 checksum(const GameEngine &engine);
+
+    quint32        seed;
+    int            missionID;
+    QVector<int>   team;            // 6 格角色 ID (0 表示空格)
+    int            totalHP;
+    QVector<Input> inputs;
+    bool           finished;
+    Outcome        outcome;
+};
@@ -0,0 +1,101 @@
+// MatchTracker.cpp
+#include "MatchTracker.h"
+
+MatchTracker::MatchTracker()
+{
+    reset(GemBoard());
+}
+
+void MatchTracker::reset(const GemBoard &board)
+{
+    planes = board.planes();
+    for (int r = 0; r < BitBoard::ROWS; ++r) updateRow(r);
+    for (int c = 0; c < BitBoard::COLS; ++c) updateColumn(c);
+
+    matchedCells = 0;
+    for (BitBoard::Mask m : rowRuns) matchedCells |= m;
+    for (BitBoard::Mask m : colRuns) matchedCells |= m;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// swap(): 兩格的屬性位元互換，只重算經過這兩格的列與欄
+////////////////////////////////////////////////////////////////////////////////
+void MatchTracker::swap(int r1, int c1, int r2, int c2)
+{
+    const BitBoard::Mask a = BitBoard::bit(r1, c1);
+    const BitBoard::Mask b = BitBoard::bit(r2, c2);
+    for (BitBoard::Mask &plane : planes.attr) {
+        const bool hasA = (plane & a) != 0;
+        const bool hasB = (plane & b) != 0;
+        if (hasA != hasB) plane ^= a | b;
+    }
+
+    updateRow(r1);
+    updateColumn(c1);
+    if (r2 != r1) updateRow(r2);
+    if (c2 != c1) updateColumn(c2);
+
+    matchedCells = 0;
+    for (BitBoard::Mask m : rowRuns) matchedCells |= m;
+    for (BitBoard::Mask m : colRuns) matchedCells |= m;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// updateRow() / updateColumn(): 與 BitBoard::findRuns 相同的位移 + AND，
+//    只取這一列 (欄) 的位元
+////////////////////////////////////////////////////////////////////////////////
+void MatchTracker::updateRow(int r)
+{
+    const BitBoard::Mask row = BitBoard::rowMask(r);
+    BitBoard::Mask runs = 0;
+    for (BitBoard::Mask plane : planes.attr) {
+        const BitBoard::Mask p = plane & row;
+        const BitBoard::Mask h = p & (p >> 1) & (p >> 2) & BitBoard::H_START;
+        runs |= h | (h << 1) | (h << 2);
+    }
+    rowRuns[r] = runs;
+}
+
+void MatchTracker::updateColumn(int c)
+{
+    const BitBoard::Mask col = BitBoard::columnMask(c);
+    BitBoard::Mask runs = 0;
+    for (BitBoard::Mask plane : planes.attr) {
+        const BitBoard::Mask p = plane & col;
+        const BitBoard::Mask v = p & (p >> BitBoard::COLS) & (p >> (2 * BitBoard::COLS));
+        runs |= v | (v << BitBoard::COLS) | (v << (2 * BitBoard::COLS));
+    }
+    colRuns[c] = runs;
+}
+
+BitBoard::Mask MatchTracker::matched() const
+{
+    return matchedCells;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// preview(): 只在 matched 格子裡依屬性切 combo 群組
+////////////////////////////////////////////////////////////////////////////////
+MatchTracker::Preview MatchTracker::preview() const
+{
+    Preview p;
+    p.matched = matchedCells;
+    p.comboCount = 0;
+    p.damage = BitBoard::count(matchedCells);
+
+    for (int a = 0; a < BitBoard::ATTR_COUNT; ++a) {
+        BitBoard::Mask runs = planes.attr[a] & matchedCells;
+        p.clearedCount[a] = BitBoard::count(runs);
+        while (runs) {
+            BitBoard::Mask group = runs & (~runs + 1);
+            for (;;) {
+                const BitBoard::Mask next = BitBoard::grow(group) & runs;
+                if (next == group) break;
+                group = next;
+            }
+            ++p.comboCount;
+            runs &= ~group;
+        }
+    }
+    return p;
+}
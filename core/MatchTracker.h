@@ -0,0 +1,44 @@
+// MatchTracker.h
+#pragma once
+
+#include "GemBoard.h"
+
+/*
+ * MatchTracker
+ *  - 轉珠途中的增量連線判定：每列記下橫向 ≥ 3 連線的格子、每欄記下直向的
+ *  - 一次相鄰交換只會改變兩格，最多影響兩列、兩欄；swap() 只重算這幾條，
+ *    O(ROWS + COLS)，不重掃整個盤面
+ *  - combo 只在 matched 格子裡切群組，給轉珠中的即時預覽使用
+ *  - 預覽只算第一輪 (之後的 cascade 要看補珠，放開前無法得知)
+ */
+class MatchTracker
+{
+public:
+    struct Preview
+    {
+        BitBoard::Mask matched;     // 目前會消除的格子
+        int            comboCount;
+        int            clearedCount[BitBoard::ATTR_COUNT];  // 各屬性會消除的格數
+        int            damage;      // 預設為消除格數；GameController 以 GameEngine::estimateDamage() 改寫
+    };
+
+    MatchTracker();
+
+    // 以整個盤面重建 (每回合開始時一次)
+    void reset(const GemBoard &board);
+
+    // 盤面上 (r1,c1) 與 (r2,c2) 交換後呼叫
+    void swap(int r1, int c1, int r2, int c2);
+
+    BitBoard::Mask matched() const;
+    Preview        preview() const;
+
+private:
+    void updateRow(int r);
+    void updateColumn(int c);
+
+    BitBoard::Planes planes;
+    BitBoard::Mask   rowRuns[BitBoard::ROWS];   // 第 r 列的橫向連線格子
+    BitBoard::Mask   colRuns[BitBoard::COLS];   // 第 c 欄的直向連線格子
+    BitBoard::Mask   matchedCells;              // 所有列、欄的聯集
+};
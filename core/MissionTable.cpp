@@ -0,0 +1,472 @@
+// MissionTable.cpp
+#include "MissionTable.h"
+#include <QDebug>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+#include <QtEndian>
+#include <cstring>
+
+// Q_INIT_RESOURCE 不能放在 namespace 裡 (靜態函式庫的資源要手動註冊)
+static void initMissionResource()
+{
+    Q_INIT_RESOURCE(missions);
+}
+
+namespace {
+
+const char    MAGIC[4] = { 'T', 'O', 'S', 'M' };
+const quint16 VERSION = 1;
+const int     HEADER_SIZE = 24;
+const int     MISSION_SIZE = 8 + 2 * BitBoard::ATTR_COUNT;
+const int     WAVE_SIZE = 4;
+const int     SLOT_SIZE = 2;
+const int     ENEMY_SIZE = 12;
+const int     MAX_DROP_WEIGHT = 0xfff;     // 5 個權重加總仍放得進 quint16
+
+const char *const ATTRIBUTE_NAMES[BitBoard::ATTR_COUNT] = {
+    "Water", "Fire", "Earth", "Light", "Dark"
+};
+
+const MissionTable *sharedOverride = nullptr;
+
+int attributeFromName(const QString &name)
+{
+    for (int a = 0; a < BitBoard::ATTR_COUNT; ++a) {
+        if (name == QLatin1String(ATTRIBUTE_NAMES[a])) return a;
+    }
+    return -1;
+}
+
+template <typename T>
+void putLE(QByteArray &out, T v)
+{
+    uchar buf[sizeof(T)];
+    qToLittleEndian(v, buf);
+    out.append(reinterpret_cast<const char *>(buf), int(sizeof(T)));
+}
+
+template <typename T>
+T getLE(const uchar *p)
+{
+    return qFromLittleEndian<T>(p);
+}
+
+} // namespace
+
+MissionTable::MissionTable()
+{
+}
+
+void MissionTable::clear()
+{
+    missions.clear();
+    waves.clear();
+    waveSlots.clear();
+    enemies.clear();
+    icons.clear();
+    missionIndex.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// loadJson(): 解析定義檔
+//    { "enemies":  [ { "id", "attribute", "hp", "cooldown", "attack", "icon" }, ... ],
+//      "missions": [ { "id", "drops": { "Fire": 2, ... }, "waves": [ [敵人 id, ...], ... ] }, ... ] }
+//    attack 沒寫為 1；drops 沒寫的屬性權重為 1
+//    波次裡也可以寫 { "enemy": id, "count": n }，代表連續 n 隻同樣的敵人
+////////////////////////////////////////////////////////////////////////////////
+bool MissionTable::loadJson(const QByteArray &json)
+{
+    clear();
+
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(json, &parseError);
+    if (!doc.isObject()) {
+        qWarning() << "[MissionTable] JSON error:" << parseError.errorString()
+                   << "at offset" << parseError.offset;
+        return false;
+    }
+    const QJsonObject root = doc.object();
+
+    // 敵人：id → EnemyDef 的 index；相同圖示只存一份
+    QHash<int, int>     enemyByID;
+    QHash<QString, int> iconByPath;
+    for (const QJsonValue &v : root.value("enemies").toArray()) {
+        const QJsonObject o = v.toObject();
+        const int id = o.value("id").toInt();
+        const int attr = attributeFromName(o.value("attribute").toString());
+        const int hp = o.value("hp").toInt();
+        const int cooldown = o.value("cooldown").toInt();
+        const int attack = o.value("attack").toInt(1);
+        const QString icon = o.value("icon").toString();
+
+        if (id <= 0 || id > 0xffff || attr < 0 || hp <= 0 ||
+            cooldown <= 0 || cooldown > 0xff || attack < 0 || attack > 0xffff ||
+            enemyByID.contains(id))
+        {
+            qWarning() << "[MissionTable] invalid enemy definition, id =" << id;
+            clear();
+            return false;
+        }
+
+        int iconIndex = iconByPath.value(icon, -1);
+        if (iconIndex < 0) {
+            iconIndex = icons.size();
+            iconByPath.insert(icon, iconIndex);
+            icons.append(icon);
+        }
+
+        EnemyDef e = EnemyDef();
+        e.maxHP = quint32(hp);
+        e.id = quint16(id);
+        e.icon = quint16(iconIndex);
+        e.attribute = quint8(attr);
+        e.cooldown = quint8(cooldown);
+        e.attack = quint16(attack);
+        enemyByID.insert(id, enemies.size());
+        enemies.append(e);
+    }
+
+    for (const QJsonValue &v : root.value("missions").toArray()) {
+        const QJsonObject o = v.toObject();
+        const int id = o.value("id").toInt();
+        const QJsonArray waveList = o.value("waves").toArray();
+        if (id <= 0 || id > 0x7fff || waveList.isEmpty() ||
+            missions.size() >= 0x7fff || waves.size() + waveList.size() > 0xffff)
+        {
+            qWarning() << "[MissionTable] invalid mission definition, id =" << id;
+            clear();
+            return false;
+        }
+
+        MissionDef m = MissionDef();
+        m.id = quint16(id);
+        m.firstWave = quint16(waves.size());
+        m.waveCount = quint16(waveList.size());
+
+        const QJsonObject drops = o.value("drops").toObject();
+        int total = 0;
+        for (int a = 0; a < BitBoard::ATTR_COUNT; ++a) {
+            const int w = drops.value(QLatin1String(ATTRIBUTE_NAMES[a])).toInt(1);
+            m.dropWeight[a] = quint16(qBound(0, w, MAX_DROP_WEIGHT));
+            total += m.dropWeight[a];
+        }
+        if (total <= 0) {
+            qWarning() << "[MissionTable] mission" << id << "has no drops";
+            clear();
+            return false;
+        }
+        m.dropTotal = quint16(total);
+
+        for (const QJsonValue &wv : waveList) {
+            WaveDef w;
+            w.firstSlot = quint16(waveSlots.size());
+            for (const QJsonValue &ev : wv.toArray()) {
+                const QJsonObject group = ev.toObject();
+                const int enemyID = ev.isObject() ? group.value("enemy").toInt() : ev.toInt();
+                const int count = ev.isObject() ? group.value("count").toInt(1) : 1;
+                const int index = enemyByID.value(enemyID, -1);
+                if (index < 0) {
+                    qWarning() << "[MissionTable] mission" << id
+                               << "uses unknown enemy" << enemyID;
+                    clear();
+                    return false;
+                }
+                // 先檢查再展開：這一波 (含之前的 group) 不能超過 MAX_WAVE_ENEMIES
+                if (count <= 0 || count > MAX_WAVE_ENEMIES - (waveSlots.size() - w.firstSlot)) {
+                    qWarning() << "[MissionTable] mission" << id << "has an invalid count"
+                               << count << "for enemy" << enemyID;
+                    clear();
+                    return false;
+                }
+                for (int n = 0; n < count; ++n) {
+                    waveSlots.append(quint16(index));
+                }
+            }
+
+            const int enemyCount = waveSlots.size() - w.firstSlot;
+            if (enemyCount <= 0 || enemyCount > MAX_WAVE_ENEMIES || waveSlots.size() > 0xffff) {
+                qWarning() << "[MissionTable] mission" << id << "has a wave with"
+                           << enemyCount << "enemies";
+                clear();
+                return false;
+            }
+            w.enemyCount = quint16(enemyCount);
+            waves.append(w);
+        }
+        missions.append(m);
+    }
+
+    if (!buildIndex()) {
+        clear();
+        return false;
+    }
+    return !missions.isEmpty();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// buildIndex(): id → index 的直接查表；有重複的 id 時回傳 false
+////////////////////////////////////////////////////////////////////////////////
+bool MissionTable::buildIndex()
+{
+    int maxID = 0;
+    for (const MissionDef &m : missions) maxID = qMax(maxID, int(m.id));
+
+    missionIndex.fill(-1, maxID + 1);
+    for (int i = 0; i < missions.size(); ++i) {
+        if (missionIndex[missions[i].id] >= 0) {
+            qWarning() << "[MissionTable] duplicate mission id" << missions[i].id;
+            return false;
+        }
+        missionIndex[missions[i].id] = qint16(i);
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// toBinary() / loadBinary(): .tosm (格式見 MissionTable.h)
+////////////////////////////////////////////////////////////////////////////////
+QByteArray MissionTable::toBinary() const
+{
+    QByteArray iconBlob;
+    QVector<quint32> iconOffsets;
+    for (const QString &path : icons) {
+        iconOffsets.append(quint32(iconBlob.size()));
+        iconBlob.append(path.toUtf8());
+    }
+    iconOffsets.append(quint32(iconBlob.size()));
+
+    QByteArray out;
+    out.append(MAGIC, 4);
+    putLE<quint16>(out, VERSION);
+    putLE<quint16>(out, quint16(HEADER_SIZE));
+    putLE<quint16>(out, quint16(missions.size()));
+    putLE<quint16>(out, quint16(waves.size()));
+    putLE<quint16>(out, quint16(waveSlots.size()));
+    putLE<quint16>(out, quint16(enemies.size()));
+    putLE<quint16>(out, quint16(icons.size()));
+    putLE<quint16>(out, 0);
+    putLE<quint32>(out, quint32(iconBlob.size()));
+
+    for (const MissionDef &m : missions) {
+        putLE<quint16>(out, m.id);
+        putLE<quint16>(out, m.firstWave);
+        putLE<quint16>(out, m.waveCount);
+        putLE<quint16>(out, m.dropTotal);
+        for (quint16 w : m.dropWeight) putLE<quint16>(out, w);
+    }
+    for (const WaveDef &w : waves) {
+        putLE<quint16>(out, w.firstSlot);
+        putLE<quint16>(out, w.enemyCount);
+    }
+    for (quint16 s : waveSlots) {
+        putLE<quint16>(out, s);
+    }
+    for (const EnemyDef &e : enemies) {
+        putLE<quint32>(out, e.maxHP);
+        putLE<quint16>(out, e.id);
+        putLE<quint16>(out, e.icon);
+        out.append(char(e.attribute));
+        out.append(char(e.cooldown));
+        putLE<quint16>(out, e.attack);
+    }
+    for (quint32 offset : iconOffsets) {
+        putLE<quint32>(out, offset);
+    }
+    out.append(iconBlob);
+    return out;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// loadBinary(): 除了長度與 index 範圍，也檢查 loadJson() 會擋下的數值
+//    (空的波次、0 血、0 cooldown、掉落權重與總和不符、重複的 id)，
+//    手改或損壞的 .tosm 不會載入 JSON 產生不出來的表
+////////////////////////////////////////////////////////////////////////////////
+bool MissionTable::loadBinary(const uchar *d, qint64 size)
+{
+    clear();
+    if (!d || size < HEADER_SIZE || std::memcmp(d, MAGIC, 4) != 0) return false;
+
+    const quint16 version = getLE<quint16>(d + 4);
+    const quint16 headerSize = getLE<quint16>(d + 6);
+    if (version != VERSION || headerSize < HEADER_SIZE) return false;
+
+    const int missionCount = getLE<quint16>(d + 8);
+    const int waveCount = getLE<quint16>(d + 10);
+    const int slotCount = getLE<quint16>(d + 12);
+    const int enemyCount = getLE<quint16>(d + 14);
+    const int iconCount = getLE<quint16>(d + 16);
+    const quint32 iconBytes = getLE<quint32>(d + 20);
+
+    const qint64 expected = qint64(headerSize) +
+                            qint64(missionCount) * MISSION_SIZE +
+                            qint64(waveCount) * WAVE_SIZE +
+                            qint64(slotCount) * SLOT_SIZE +
+                            qint64(enemyCount) * ENEMY_SIZE +
+                            qint64(iconCount + 1) * 4 + iconBytes;
+    if (size < expected) return false;
+
+    const uchar *p = d + headerSize;
+
+    missions.resize(missionCount);
+    for (MissionDef &m : missions) {
+        m.id = getLE<quint16>(p);
+        m.firstWave = getLE<quint16>(p + 2);
+        m.waveCount = getLE<quint16>(p + 4);
+        m.dropTotal = getLE<quint16>(p + 6);
+        int total = 0;
+        bool weightsValid = true;
+        for (int a = 0; a < BitBoard::ATTR_COUNT; ++a) {
+            m.dropWeight[a] = getLE<quint16>(p + 8 + 2 * a);
+            total += m.dropWeight[a];
+            weightsValid &= m.dropWeight[a] <= MAX_DROP_WEIGHT;
+        }
+        p += MISSION_SIZE;
+        if (m.id == 0 || m.id > 0x7fff || m.waveCount == 0 || m.firstWave + m.waveCount > waveCount ||
+            !weightsValid || m.dropTotal == 0 || m.dropTotal != total)
+        {
+            clear();
+            return false;
+        }
+    }
+
+    waves.resize(waveCount);
+    for (WaveDef &w : waves) {
+        w.firstSlot = getLE<quint16>(p);
+        w.enemyCount = getLE<quint16>(p + 2);
+        p += WAVE_SIZE;
+        if (w.enemyCount == 0 || w.enemyCount > MAX_WAVE_ENEMIES ||
+            w.firstSlot + w.enemyCount > slotCount)
+        {
+            clear();
+            return false;
+        }
+    }
+
+    waveSlots.resize(slotCount);
+    for (quint16 &s : waveSlots) {
+        s = getLE<quint16>(p);
+        p += SLOT_SIZE;
+        if (s >= enemyCount) {
+            clear();
+            return false;
+        }
+    }
+
+    QSet<quint16> enemyIDs;
+    enemies.resize(enemyCount);
+    for (EnemyDef &e : enemies) {
+        e.maxHP = getLE<quint32>(p);
+        e.id = getLE<quint16>(p + 4);
+        e.icon = getLE<quint16>(p + 6);
+        e.attribute = p[8];
+        e.cooldown = p[9];
+        e.attack = getLE<quint16>(p + 10);
+        p += ENEMY_SIZE;
+        if (e.maxHP == 0 || e.maxHP > 0x7fffffff || e.id == 0 || e.cooldown == 0 ||
+            e.icon >= iconCount || e.attribute >= BitBoard::ATTR_COUNT || enemyIDs.contains(e.id))
+        {
+            clear();
+            return false;
+        }
+        enemyIDs.insert(e.id);
+    }
+
+    const uchar *blob = p + (iconCount + 1) * 4;
+    icons.resize(iconCount);
+    for (int i = 0; i < iconCount; ++i) {
+        const quint32 begin = getLE<quint32>(p + 4 * i);
+        const quint32 end = getLE<quint32>(p + 4 * (i + 1));
+        if (begin > end || end > iconBytes) {
+            clear();
+            return false;
+        }
+        icons[i] = QString::fromUtf8(reinterpret_cast<const char *>(blob + begin), int(end - begin));
+    }
+
+    if (!buildIndex()) {
+        clear();
+        return false;
+    }
+    return !missions.isEmpty();
+}
+
+bool MissionTable::loadFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "[MissionTable] cannot open" << path;
+        return false;
+    }
+    const QByteArray bytes = file.readAll();
+    if (bytes.startsWith(QByteArray(MAGIC, 4))) {
+        return loadBinary(reinterpret_cast<const uchar *>(bytes.constData()), bytes.size());
+    }
+    return loadJson(bytes);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 查表
+////////////////////////////////////////////////////////////////////////////////
+bool MissionTable::isEmpty() const
+{
+    return missions.isEmpty();
+}
+
+int MissionTable::missionCount() const
+{
+    return missions.size();
+}
+
+int MissionTable::maxMissionID() const
+{
+    return missionIndex.size() - 1;
+}
+
+const MissionTable::MissionDef *MissionTable::mission(int id) const
+{
+    if (id < 0 || id >= missionIndex.size() || missionIndex[id] < 0) return nullptr;
+    return &missions[missionIndex[id]];
+}
+
+const MissionTable::WaveDef &MissionTable::wave(const MissionDef &m, int waveIndex) const
+{
+    return waves[m.firstWave + waveIndex];
+}
+
+const MissionTable::EnemyDef &MissionTable::enemy(const WaveDef &w, int slot) const
+{
+    return enemies[waveSlots[w.firstSlot + slot]];
+}
+
+const QString &MissionTable::iconPath(const EnemyDef &e) const
+{
+    return icons[e.icon];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// shared(): 第一次呼叫時解析內建定義檔 (C++11 保證只初始化一次)
+////////////////////////////////////////////////////////////////////////////////
+const MissionTable &MissionTable::shared()
+{
+    if (sharedOverride) return *sharedOverride;
+
+    static const MissionTable builtin = []() {
+        initMissionResource();
+        MissionTable table;
+        if (!table.loadFile(":/core/data/missions.json")) {
+            qWarning() << "[MissionTable] built-in mission definitions failed to load";
+        }
+        return table;
+    }();
+    return builtin;
+}
+
+void MissionTable::setShared(const MissionTable &table)
+{
+    // 只在啟動時呼叫一次；舊的表可能仍被 engine 參照，所以不釋放
+    sharedOverride = new MissionTable(table);
+}
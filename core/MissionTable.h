@@ -0,0 +1,106 @@
+// MissionTable.h
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include "BitBoard.h"
+
+/*
+ * MissionTable
+ *  - 所有 mission 的波次、敵人數值 (HP / 屬性 / cooldown / 圖示) 與符石掉落權重
+ *  - 定義檔為 JSON (預設內建 :/core/data/missions.json)，啟動時解析一次成唯讀的表：
+ *    定長 record 的連續陣列 + 一份圖示路徑表，之後不再修改，可跨 thread 共用
+ *  - 也可存成預先編好的二進位檔 (.tosm，little-endian)，載入時不解析字串、直接讀 record，
+ *    只檢查長度與 loadJson() 同樣的數值限制
+ *  - mission(id) 是陣列查表；開始 mission 時不組字串、不配置表格
+ *
+ *  .tosm 格式
+ *    Header   24 bytes：magic "TOSM"、版本、headerSize、各陣列筆數、圖示字串總長
+ *    Missions missionCount × 18 bytes { id, firstWave, waveCount, dropTotal, dropWeight[5] }
+ *    Waves    waveCount × 4 bytes     { firstEnemy, enemyCount }
+ *    Slots    slotCount × 2 bytes     每波依序的敵人 (EnemyDef 的 index)
+ *    Enemies  enemyCount × 12 bytes   { maxHP, id, icon, attribute, cooldown, attack }
+ *    Icons    (iconCount + 1) × u32 offset，接著是 UTF-8 字串本體
+ */
+class MissionTable
+{
+public:
+    struct MissionDef
+    {
+        quint16 id;
+        quint16 firstWave;                      // waves 陣列的起點
+        quint16 waveCount;
+        quint16 dropTotal;                      // dropWeight 總和 (> 0)
+        quint16 dropWeight[BitBoard::ATTR_COUNT];   // 補珠時各屬性的相對權重
+
+        // pick 在 [0, dropTotal) 之間 → 屬性
+        int dropAttribute(int pick) const
+        {
+            int a = 0;
+            while (a < BitBoard::ATTR_COUNT - 1 && pick >= dropWeight[a]) {
+                pick -= dropWeight[a];
+                ++a;
+            }
+            return a;
+        }
+    };
+
+    struct WaveDef
+    {
+        quint16 firstSlot;                      // waveSlots 陣列的起點
+        quint16 enemyCount;
+    };
+
+    struct EnemyDef
+    {
+        quint32 maxHP;
+        quint16 id;
+        quint16 icon;                           // iconPath() 的 index
+        quint8  attribute;                      // Character::Attribute
+        quint8  cooldown;                       // cooldownDefault
+        quint16 attack;                         // 每次攻擊的傷害 (預設 1)
+    };
+
+    // 每波敵人上限 (壓力測試用的 mission 可以到上百隻)
+    static constexpr int MAX_WAVE_ENEMIES = 1024;
+
+    MissionTable();
+
+    // 以 JSON 定義檔內容建立 (失敗時表格為空並回傳 false)
+    bool loadJson(const QByteArray &json);
+
+    // 以 .tosm 內容建立 (數值不符 loadJson() 的限制時同樣回傳 false)
+    bool loadBinary(const uchar *data, qint64 size);
+
+    // 依 magic 判斷是 .tosm 還是 JSON
+    bool loadFile(const QString &path);
+
+    // 存成 .tosm
+    QByteArray toBinary() const;
+
+    bool isEmpty() const;
+    int  missionCount() const;
+    int  maxMissionID() const;
+
+    // 查表；沒有這個 mission 回傳 nullptr
+    const MissionDef *mission(int id) const;
+    const WaveDef    &wave(const MissionDef &m, int waveIndex) const;
+    const EnemyDef   &enemy(const WaveDef &w, int slot) const;
+    const QString    &iconPath(const EnemyDef &e) const;
+
+    // 全程式共用的表：預設載入內建的定義檔；setShared() 需在任何 engine 開始 mission 前呼叫
+    static const MissionTable &shared();
+    static void setShared(const MissionTable &table);
+
+private:
+    void clear();
+    bool buildIndex();
+
+    QVector<MissionDef> missions;
+    QVector<WaveDef>    waves;
+    QVector<quint16>    waveSlots;
+    QVector<EnemyDef>   enemies;
+    QVector<QString>    icons;
+    QVector<qint16>     missionIndex;           // id → missions 的 index (-1 表示沒有)
+};
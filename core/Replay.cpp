@@ -0,0 +1,69 @@
+// Replay.cpp
+#include "Replay.h"
+#include <QtAlgorithms>
+
+////////////////////////////////////////////////////////////////////////////////
+// apply(): 套用一筆輸入
+////////////////////////////////////////////////////////////////////////////////
+bool Replay::apply(GameEngine &engine, const InputLog::Input &input)
+{
+    if (engine.phase() != GameEngine::PlayerMove) return false;
+
+    switch (input.type) {
+        case InputLog::Swap:
+            if (input.r1 >= GemBoard::ROWS || input.r2 >= GemBoard::ROWS ||
+                input.c1 >= GemBoard::COLS || input.c2 >= GemBoard::COLS)
+            {
+                return false;
+            }
+            return engine.swapGems(input.r1, input.c1, input.r2, input.c2);
+
+        case InputLog::EndMove:
+            engine.endMove();
+            while (engine.phase() != GameEngine::PlayerMove &&
+                   engine.phase() != GameEngine::Won &&
+                   engine.phase() != GameEngine::Lost)
+            {
+                engine.step();
+            }
+            return true;
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// run(): 從頭重播一整局
+////////////////////////////////////////////////////////////////////////////////
+Replay::Result Replay::run(const InputLog &log)
+{
+    Result result = Result();
+
+    QVector<Character*> party = Character::createParty(log.team, log.totalHP);
+
+    GameEngine engine;
+    engine.setSeed(log.seed);
+    engine.init(party, log.missionID);
+    engine.startMission();
+
+    result.completed = true;
+    for (const InputLog::Input &input : log.inputs) {
+        if (!apply(engine, input)) {
+            result.completed = false;
+            break;
+        }
+        ++result.inputsApplied;
+    }
+
+    result.outcome.phase = quint8(engine.phase());
+    result.outcome.turns = engine.turn();
+    result.outcome.wave = engine.currentWave();
+    result.outcome.checksum = InputLog::checksum(engine);
+    result.matches = result.completed && log.finished &&
+                     result.outcome.phase == log.outcome.phase &&
+                     result.outcome.turns == log.outcome.turns &&
+                     result.outcome.wave == log.outcome.wave &&
+                     result.outcome.checksum == log.outcome.checksum;
+
+    qDeleteAll(party);
+    return result;
+}
@@ -0,0 +1,27 @@
+// Replay.h
+#pragma once
+
+#include "InputLog.h"
+
+/*
+ * Replay
+ *  - 以 InputLog 重建隊伍、設定種子，依序把輸入餵給 GameEngine
+ *  - 不經過 event loop、不等動畫、忽略 tickMs，以最快速度跑完
+ *  - 跑完後比對 InputLog 記下的結果，確認重播與原本那局完全一致
+ */
+class Replay
+{
+public:
+    struct Result
+    {
+        bool              completed;        // 所有輸入都在 PlayerMove 時套用成功
+        bool              matches;          // 結果與紀錄一致 (紀錄未結束時為 false)
+        int               inputsApplied;
+        InputLog::Outcome outcome;          // 重播的結果
+    };
+
+    static Result run(const InputLog &log);
+
+    // 套用一筆輸入；EndMove 會一路 step() 到下一個 PlayerMove / Won / Lost
+    static bool apply(GameEngine &engine, const InputLog::Input &input);
+};
@@ -0,0 +1,513 @@
+// ReplayFile.cpp
+#include "ReplayFile.h"
+#include "Replay.h"
+#include <QDir>
+#include <QFile>
+#include <QPair>
+#include <QtAlgorithms>
+#include <QtEndian>
+#include <cstring>
+
+namespace {
+
+const char    MAGIC[4] = { 'T', 'O', 'S', 'R' };
+const quint16 VERSION = 3;          // v3：keyframe 的 wave 改為 u16 (回合紀錄與 v2 相同)
+const quint16 MIN_VERSION = 2;      // v2：傷害改為屬性相剋 + combo 倍率，v1 的重播無法重現
+const int     HEADER_SIZE = 56;
+const quint8  FAR_SWAP = 0xFF;         // 非相鄰交換的前綴
+const quint8  EMPTY_CELL = 0xFF;
+const int     KEYFRAME_FIXED_SIZE = 17 + BitBoard::CELLS;
+const int     KEYFRAME_FIXED_SIZE_V2 = 16 + BitBoard::CELLS;
+const int     INDEX_ENTRY_SIZE = 8;
+
+// 方向與 DragSolver 相同：上、下、左、右
+const int DR[4] = { -1, 1, 0, 0 };
+const int DC[4] = { 0, 0, -1, 1 };
+
+////////////////////////////////////////////////////////////////////////////////
+// varint (LEB128) 與 little-endian 定長欄位
+////////////////////////////////////////////////////////////////////////////////
+void putVarint(QByteArray &out, quint32 v)
+{
+    while (v >= 0x80) {
+        out.append(char(v | 0x80));
+        v >>= 7;
+    }
+    out.append(char(v));
+}
+
+bool getVarint(const uchar *&p, const uchar *end, quint32 &v)
+{
+    v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (p >= end) return false;
+        const uchar b = *p++;
+        v |= quint32(b & 0x7f) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+template <typename T>
+void putLE(QByteArray &out, T v)
+{
+    uchar buf[sizeof(T)];
+    qToLittleEndian(v, buf);
+    out.append(reinterpret_cast<const char *>(buf), int(sizeof(T)));
+}
+
+template <typename T>
+void setLE(QByteArray &out, int offset, T v)
+{
+    qToLittleEndian(v, reinterpret_cast<uchar *>(out.data()) + offset);
+}
+
+template <typename T>
+T getLE(const uchar *p)
+{
+    return qFromLittleEndian<T>(p);
+}
+
+quint8 encodeCell(const Gem &g)
+{
+    return g.isEmpty() ? EMPTY_CELL
+                       : quint8(quint8(g.getType()) | (quint8(g.getEffectStatus()) << 4));
+}
+
+Gem decodeCell(quint8 b)
+{
+    if (b == EMPTY_CELL) return Gem::empty();
+    return Gem::make(static_cast<Gem::Attribute>(b & 0x0f),
+                     static_cast<Gem::EffectStatus>(b >> 4));
+}
+
+int directionOf(int r1, int c1, int r2, int c2)
+{
+    for (int d = 0; d < 4; ++d) {
+        if (r1 + DR[d] == r2 && c1 + DC[d] == c2) return d;
+    }
+    return -1;
+}
+
+void putSwap(QByteArray &out, const InputLog::Input &in)
+{
+    const int dir = directionOf(in.r1, in.c1, in.r2, in.c2);
+    if (dir >= 0) {
+        out.append(char((in.r1 * GemBoard::COLS + in.c1) * 4 + dir));
+    } else {
+        out.append(char(FAR_SWAP));
+        out.append(char(in.r1 * GemBoard::COLS + in.c1));
+        out.append(char(in.r2 * GemBoard::COLS + in.c2));
+    }
+}
+
+void putKeyframe(QByteArray &out, const GameEngine::Snapshot &s,
+                 quint32 recordOffset, quint32 tickBase)
+{
+    putLE<quint32>(out, quint32(s.turn));
+    putLE<quint32>(out, recordOffset);
+    putLE<quint32>(out, tickBase);
+    putLE<quint16>(out, quint16(s.wave));           // MissionDef::waveCount 是 u16
+    putLE<quint16>(out, quint16(s.enemyCount));
+    out.append(char(s.playerCount));
+    for (int i = 0; i < GemBoard::CELLS; ++i) {
+        out.append(char(encodeCell(s.board.cell(i))));
+    }
+    for (int i = 0; i < s.playerCount; ++i) putVarint(out, quint32(s.playerHP[i]));
+    for (int i = 0; i < s.enemyCount; ++i)  putVarint(out, quint32(s.enemyHP[i]));
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// ReplayWriter::write(): 由 InputLog 跑一次 engine，邊跑邊寫回合紀錄與 keyframe
+////////////////////////////////////////////////////////////////////////////////
+bool ReplayWriter::write(const InputLog &log, QIODevice *device, int keyframeInterval)
+{
+    keyframeInterval = qBound(1, keyframeInterval, 0xffff);
+
+    QByteArray out(HEADER_SIZE, 0);
+    QByteArray keyframes;
+    QVector<QPair<quint32, quint32>> index;     // turn, keyframes 內的 offset
+
+    QVector<Character*> party = Character::createParty(log.team, log.totalHP);
+    GameEngine engine;
+    engine.setSeed(log.seed);
+    engine.init(party, log.missionID);
+    engine.startMission();
+
+    const QVector<InputLog::Input> &inputs = log.inputs;
+    quint32 prevTick = 0;
+    int turn = 0;
+    int i = 0;
+
+    for (;;) {
+        if (turn % keyframeInterval == 0 && engine.phase() == GameEngine::PlayerMove) {
+            index.append(qMakePair(quint32(turn), quint32(keyframes.size())));
+            putKeyframe(keyframes, engine.snapshot(), quint32(out.size()), prevTick);
+        }
+        if (i >= inputs.size()) break;
+
+        // 一回合 = 連續的交換 + 一個 EndMove
+        int j = i;
+        while (j < inputs.size() && inputs[j].type == InputLog::Swap) ++j;
+
+        putVarint(out, quint32(j - i));
+        for (; i < j; ++i) {
+            const InputLog::Input &in = inputs[i];
+            const quint32 tick = qMax(prevTick, in.tickMs);
+            putVarint(out, tick - prevTick);
+            putSwap(out, in);
+            prevTick = tick;
+            Replay::apply(engine, in);
+        }
+
+        if (i < inputs.size()) {
+            const InputLog::Input &in = inputs[i];
+            const quint32 tick = qMax(prevTick, in.tickMs);
+            putVarint(out, tick - prevTick + 1);
+            prevTick = tick;
+            Replay::apply(engine, in);
+            ++i;
+        } else {
+            putVarint(out, 0);
+        }
+        ++turn;
+    }
+
+    qDeleteAll(party);
+
+    // keyframe 接在回合紀錄後面，索引再接在最後
+    const quint32 keyframeBase = quint32(out.size());
+    out.append(keyframes);
+    const quint32 indexOffset = quint32(out.size());
+    for (const auto &entry : index) {
+        putLE<quint32>(out, entry.first);
+        putLE<quint32>(out, keyframeBase + entry.second);
+    }
+
+    std::memcpy(out.data(), MAGIC, 4);
+    setLE<quint16>(out, 4, VERSION);
+    setLE<quint16>(out, 6, quint16(HEADER_SIZE));
+    setLE<quint32>(out, 8, log.seed);
+    setLE<quint32>(out, 12, quint32(log.totalHP));
+    setLE<quint16>(out, 16, quint16(log.missionID));
+    setLE<quint16>(out, 18, quint16(keyframeInterval));
+    for (int t = 0; t < 6; ++t) {
+        out[20 + t] = char(t < log.team.size() ? log.team[t] : 0);
+    }
+    out[26] = char(log.finished ? 1 : 0);
+    out[27] = char(log.outcome.phase);
+    setLE<quint32>(out, 28, quint32(turn));
+    setLE<quint32>(out, 32, quint32(log.outcome.wave));
+    setLE<quint32>(out, 36, quint32(index.size()));
+    setLE<quint32>(out, 40, indexOffset);
+    setLE<quint32>(out, 44, quint32(inputs.size()));
+    setLE<quint64>(out, 48, log.outcome.checksum);
+
+    return device->write(out) == out.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ReplayReader
+////////////////////////////////////////////////////////////////////////////////
+ReplayReader::ReplayReader()
+    : data(nullptr),
+      size(0),
+      recordsBegin(0),
+      recordsEnd(0)
+{
+    head = Header();
+}
+
+bool ReplayReader::open(const uchar *d, qint64 s)
+{
+    data = nullptr;
+    size = 0;
+    if (!d || s < HEADER_SIZE || std::memcmp(d, MAGIC, 4) != 0) return false;
+
+    Header h;
+    h.version = getLE<quint16>(d + 4);
+    const quint16 headerSize = getLE<quint16>(d + 6);
+    if (h.version < MIN_VERSION || h.version > VERSION || headerSize < HEADER_SIZE) return false;
+
+    h.seed = getLE<quint32>(d + 8);
+    h.totalHP = getLE<quint32>(d + 12);
+    h.missionID = getLE<quint16>(d + 16);
+    h.keyframeInterval = getLE<quint16>(d + 18);
+    std::memcpy(h.team, d + 20, 6);
+    h.finished = d[26] != 0;
+    h.finalPhase = d[27];
+    h.turnCount = getLE<quint32>(d + 28);
+    h.finalWave = getLE<quint32>(d + 32);
+    h.keyframeCount = getLE<quint32>(d + 36);
+    h.indexOffset = getLE<quint32>(d + 40);
+    h.inputCount = getLE<quint32>(d + 44);
+    h.checksum = getLE<quint64>(d + 48);
+
+    if (h.indexOffset < headerSize ||
+        qint64(h.indexOffset) + qint64(h.keyframeCount) * INDEX_ENTRY_SIZE > s)
+    {
+        return false;
+    }
+
+    // 回合紀錄到第一個 keyframe (沒有 keyframe 時到索引) 為止
+    quint32 recEnd = h.indexOffset;
+    if (h.keyframeCount) {
+        recEnd = getLE<quint32>(d + h.indexOffset + 4);
+        if (recEnd < headerSize || recEnd > h.indexOffset) return false;
+    }
+
+    data = d;
+    size = s;
+    head = h;
+    recordsEnd = recEnd;
+    recordsBegin = headerSize;
+    return true;
+}
+
+const ReplayReader::Header &ReplayReader::header() const
+{
+    return head;
+}
+
+QVector<int> ReplayReader::team() const
+{
+    QVector<int> t(6);
+    for (int i = 0; i < 6; ++i) t[i] = head.team[i];
+    return t;
+}
+
+ReplayReader::Cursor ReplayReader::cursor() const
+{
+    Cursor c;
+    if (data) {
+        c.pos = data + recordsBegin;
+        c.end = data + recordsEnd;
+    }
+    return c;
+}
+
+void ReplayReader::startEngine(GameEngine &engine, QVector<Character*> &party) const
+{
+    party = Character::createParty(team(), int(head.totalHP));
+    engine.setSeed(head.seed);
+    engine.init(party, head.missionID);
+    engine.startMission();
+}
+
+bool ReplayReader::readKeyframe(int k, GameEngine::Snapshot &s,
+                                quint32 &recordOffset, quint32 &tickBase) const
+{
+    const bool wideWave = head.version >= 3;
+    const int fixedSize = wideWave ? KEYFRAME_FIXED_SIZE : KEYFRAME_FIXED_SIZE_V2;
+    const quint32 offset = getLE<quint32>(data + head.indexOffset + k * INDEX_ENTRY_SIZE + 4);
+    if (qint64(offset) + fixedSize > head.indexOffset) return false;
+
+    const uchar *p = data + offset;
+    const uchar *end = data + head.indexOffset;
+
+    s = GameEngine::Snapshot();
+    s.turn = int(getLE<quint32>(p));
+    recordOffset = getLE<quint32>(p + 4);
+    tickBase = getLE<quint32>(p + 8);
+    if (wideWave) {
+        s.wave = getLE<quint16>(p + 12);
+        s.enemyCount = getLE<quint16>(p + 14);
+        s.playerCount = p[16];
+    } else {
+        s.wave = p[12];
+        s.playerCount = p[13];
+        s.enemyCount = getLE<quint16>(p + 14);
+    }
+
+    // v2 的 wave 在超過 255 波的 mission 裡已被截斷，無法判斷是哪一波
+    const MissionTable::MissionDef *mission = MissionTable::shared().mission(head.missionID);
+    if (!mission || s.wave >= mission->waveCount || (!wideWave && mission->waveCount > 0xff) ||
+        s.playerCount > GameEngine::MAX_SNAPSHOT_PLAYERS ||
+        s.enemyCount > MissionTable::MAX_WAVE_ENEMIES ||
+        recordOffset < recordsBegin || recordOffset > recordsEnd)
+    {
+        return false;
+    }
+    s.enemyHP.resize(s.enemyCount);
+
+    p += fixedSize - GemBoard::CELLS;
+    for (int i = 0; i < GemBoard::CELLS; ++i) {
+        s.board.cell(i) = decodeCell(*p++);
+    }
+
+    quint32 hp = 0;
+    for (int i = 0; i < s.playerCount; ++i) {
+        if (!getVarint(p, end, hp)) return false;
+        s.playerHP[i] = int(hp);
+    }
+    for (int i = 0; i < s.enemyCount; ++i) {
+        if (!getVarint(p, end, hp)) return false;
+        s.enemyHP[i] = int(hp);
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// seek(): 二分搜尋最近的 keyframe → 還原 → 重播剩下不到 keyframeInterval 回合
+////////////////////////////////////////////////////////////////////////////////
+bool ReplayReader::seek(int turn, GameEngine &engine, Cursor *cursorOut) const
+{
+    if (!data || turn < 0 || quint32(turn) > head.turnCount || !head.keyframeCount) return false;
+
+    int lo = 0;
+    int hi = int(head.keyframeCount) - 1;
+    int found = -1;
+    while (lo <= hi) {
+        const int mid = (lo + hi) / 2;
+        const quint32 kfTurn = getLE<quint32>(data + head.indexOffset + mid * INDEX_ENTRY_SIZE);
+        if (kfTurn <= quint32(turn)) {
+            found = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    if (found < 0) return false;
+
+    GameEngine::Snapshot snap;
+    quint32 recordOffset = 0;
+    quint32 tickBase = 0;
+    if (!readKeyframe(found, snap, recordOffset, tickBase) || !engine.restore(snap)) return false;
+
+    Cursor c;
+    c.pos = data + recordOffset;
+    c.end = data + recordsEnd;
+    c.currentTurn = snap.turn;
+    c.tick = tickBase;
+
+    InputLog::Input input;
+    while (c.turn() < turn) {
+        if (!c.next(input) || !Replay::apply(engine, input)) return false;
+    }
+
+    if (cursorOut) *cursorOut = c;
+    return true;
+}
+
+InputLog ReplayReader::toInputLog() const
+{
+    InputLog log;
+    log.begin(head.seed, head.missionID, team(), int(head.totalHP));
+    log.inputs.reserve(int(head.inputCount));
+
+    Cursor c = cursor();
+    InputLog::Input input;
+    while (c.next(input)) {
+        log.inputs.append(input);
+    }
+
+    log.finished = head.finished;
+    log.outcome.phase = head.finalPhase;
+    log.outcome.turns = int(head.turnCount);
+    log.outcome.wave = int(head.finalWave);
+    log.outcome.checksum = head.checksum;
+    return log;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ReplayReader::Cursor: 逐筆解 varint，不配置記憶體
+////////////////////////////////////////////////////////////////////////////////
+ReplayReader::Cursor::Cursor()
+    : pos(nullptr),
+      end(nullptr),
+      currentTurn(0),
+      tick(0),
+      swapsLeft(0),
+      inTurn(false)
+{
+}
+
+bool ReplayReader::Cursor::next(InputLog::Input &input)
+{
+    for (;;) {
+        if (!inTurn) {
+            if (pos >= end || !getVarint(pos, end, swapsLeft)) return false;
+            inTurn = true;
+        }
+
+        quint32 delta = 0;
+        if (swapsLeft > 0) {
+            if (!getVarint(pos, end, delta) || pos >= end) return false;
+            int from = 0;
+            int to = 0;
+            const quint8 code = *pos++;
+            if (code == FAR_SWAP) {
+                if (end - pos < 2) return false;
+                from = pos[0];
+                to = pos[1];
+                pos += 2;
+            } else {
+                from = code >> 2;
+                const int dir = code & 3;
+                to = from + DR[dir] * GemBoard::COLS + DC[dir];
+            }
+            if (from >= GemBoard::CELLS || to < 0 || to >= GemBoard::CELLS) return false;
+
+            --swapsLeft;
+            tick += delta;
+            input.tickMs = tick;
+            input.type = InputLog::Swap;
+            input.r1 = quint8(BitBoard::rowOf(from));
+            input.c1 = quint8(BitBoard::colOf(from));
+            input.r2 = quint8(BitBoard::rowOf(to));
+            input.c2 = quint8(BitBoard::colOf(to));
+            return true;
+        }
+
+        // 回合結尾：0 表示紀錄在這回合中斷
+        if (!getVarint(pos, end, delta)) return false;
+        inTurn = false;
+        ++currentTurn;
+        if (delta == 0) continue;
+
+        tick += delta - 1;
+        input = InputLog::Input();
+        input.tickMs = tick;
+        input.type = InputLog::EndMove;
+        return true;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ReplayArchive: QFile::map (mmap) 後直接交給 reader，用完立刻 unmap
+////////////////////////////////////////////////////////////////////////////////
+bool ReplayArchive::mapFile(const QString &path, const Visitor &visitor, bool *keepGoing)
+{
+    if (keepGoing) *keepGoing = true;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly) || file.size() < HEADER_SIZE) return false;
+
+    uchar *mapped = file.map(0, file.size());
+    if (!mapped) return false;
+
+    ReplayReader reader;
+    const bool ok = reader.open(mapped, file.size());
+    if (ok) {
+        const bool more = visitor(path, reader);
+        if (keepGoing) *keepGoing = more;
+    }
+    file.unmap(mapped);
+    return ok;
+}
+
+int ReplayArchive::scan(const QString &directory, const Visitor &visitor)
+{
+    QDir dir(directory);
+    const QStringList names = dir.entryList(QStringList() << "*.tosreplay",
+                                            QDir::Files, QDir::Name);
+    int count = 0;
+    for (const QString &name : names) {
+        bool keepGoing = true;
+        if (mapFile(dir.filePath(name), visitor, &keepGoing)) ++count;
+        if (!keepGoing) break;
+    }
+    return count;
+}
@@ -0,0 +1,125 @@
+// ReplayFile.h
+#pragma once
+
+#include <QIODevice>
+#include <QString>
+#include <functional>
+#include "InputLog.h"
+
+/*
+ * 重播檔格式 (.tosreplay，little-endian)
+ *
+ *   Header      固定 56 bytes：magic "TOSR"、版本、種子、missionID、隊伍、總 HP、
+ *               keyframe 間隔、回合數、結果 (phase / wave / checksum)、keyframe 索引位置
+ *   Turn 紀錄   每回合一筆，全部以 varint (LEB128) 打包：
+ *                 swapCount
+ *                 swapCount × { tickDelta, code }   code = cell * 4 + 方向 (1 byte)；
+ *                                                   非相鄰交換為 0xFF + cell1 + cell2
+ *                 endTickDelta + 1                  0 表示這回合沒有結束 (紀錄中斷)
+ *               tickDelta 都是相對前一筆輸入的毫秒數
+ *   Keyframe    每 keyframeInterval 回合一個 GameEngine::Snapshot (盤面 30 bytes + varint HP；
+ *               波次與敵人數為 u16：一個 mission 可以超過 255 波、一波可以有上百隻)，
+ *               另外記下該回合紀錄的位置與 tick 基準
+ *               (v2 的 wave 只有 1 byte，回合紀錄相同，仍然可以讀)
+ *   Index       keyframeCount × { turn u32, keyframeOffset u32 }
+ *
+ *  - ReplayWriter：由 InputLog 寫出 (會實際跑一次 engine 以取得 keyframe)
+ *  - ReplayReader：直接讀記憶體 (通常是 mmap)，不複製資料；seek() 從最近的 keyframe
+ *    還原後最多只需重播 keyframeInterval - 1 回合
+ *  - ReplayArchive：逐一 mmap 資料夾裡的重播檔交給 visitor，同一時間只對應一個檔案
+ */
+
+class ReplayWriter
+{
+public:
+    static constexpr int DEFAULT_KEYFRAME_INTERVAL = 8;
+
+    static bool write(const InputLog &log, QIODevice *device,
+                      int keyframeInterval = DEFAULT_KEYFRAME_INTERVAL);
+};
+
+class ReplayReader
+{
+public:
+    struct Header
+    {
+        quint16 version;
+        quint32 seed;
+        quint32 totalHP;
+        quint16 missionID;
+        quint16 keyframeInterval;
+        quint8  team[6];
+        bool    finished;
+        quint8  finalPhase;
+        quint32 turnCount;
+        quint32 finalWave;
+        quint32 keyframeCount;
+        quint32 indexOffset;
+        quint32 inputCount;
+        quint64 checksum;
+    };
+
+    // 依序解出輸入 (不配置記憶體)
+    class Cursor
+    {
+    public:
+        Cursor();
+
+        // 下一筆輸入；turn() 為目前所在 (下一筆輸入所屬) 的回合
+        bool next(InputLog::Input &input);
+        int  turn() const { return currentTurn; }
+
+    private:
+        friend class ReplayReader;
+
+        const uchar *pos;
+        const uchar *end;
+        int          currentTurn;
+        quint32      tick;
+        quint32      swapsLeft;     // 這回合還沒讀的交換數
+        bool         inTurn;        // 已讀過這回合的 swapCount
+    };
+
+    ReplayReader();
+
+    // 以一段記憶體 (mmap 的檔案內容) 開啟；資料必須在 reader 使用期間有效
+    bool open(const uchar *data, qint64 size);
+
+    const Header &header() const;
+    QVector<int>  team() const;
+
+    // 由第 0 回合開始的游標
+    Cursor cursor() const;
+
+    // 依 header 建立隊伍並讓 engine 進入第 0 回合；呼叫端負責 delete party
+    void startEngine(GameEngine &engine, QVector<Character*> &party) const;
+
+    // engine (已 startEngine) 跳到第 turn 回合開始時；cursor 停在該回合第一筆輸入
+    bool seek(int turn, GameEngine &engine, Cursor *cursor = nullptr) const;
+
+    // 轉回 InputLog (給舊工具或重新寫檔)
+    InputLog toInputLog() const;
+
+private:
+    bool readKeyframe(int index, GameEngine::Snapshot &snapshot,
+                      quint32 &recordOffset, quint32 &tickBase) const;
+
+    const uchar *data;
+    qint64       size;
+    quint32      recordsBegin;      // 回合紀錄的範圍
+    quint32      recordsEnd;
+    Header       head;
+};
+
+class ReplayArchive
+{
+public:
+    // visitor 回傳 false 會提前結束
+    typedef std::function<bool(const QString &path, const ReplayReader &reader)> Visitor;
+
+    // mmap 單一檔案並交給 visitor (回傳檔案是否能讀；keepGoing 為 visitor 的回傳值)
+    static bool mapFile(const QString &path, const Visitor &visitor, bool *keepGoing = nullptr);
+
+    // 依檔名順序 mmap 資料夾裡的所有 *.tosreplay；回傳成功讀取的檔案數
+    static int scan(const QString &directory, const Visitor &visitor);
+};
@@ -0,0 +1,195 @@
+// Trace.cpp
+#include "Trace.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStandardPaths>
+#include <QTextStream>
+#include <QThread>
+#include <QVector>
+#include <atomic>
+#include <memory>
+
+namespace {
+
+struct Event
+{
+    const char *name;
+    qint64      ts;         // ns
+    qint64      dur;        // ns ('X')；'b' / 'e' 存的是 id
+    char        phase;      // 'X' / 'b' / 'e'
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// ThreadBuffer: 只有擁有的 thread 寫入
+//    written 是寫入過的總筆數；第 n 筆放在 events[n % BUFFER_EVENTS]
+////////////////////////////////////////////////////////////////////////////////
+struct ThreadBuffer
+{
+    int                   tid;
+    QString               threadName;
+    std::atomic<quint64>  written;
+    Event                 events[Trace::BUFFER_EVENTS];
+};
+
+struct Registry
+{
+    QElapsedTimer clock;
+    QMutex        mutex;    // 只保護 buffers 清單 (新 thread 註冊、write())
+    QVector<std::shared_ptr<ThreadBuffer>> buffers;
+
+    Registry() { clock.start(); }
+};
+
+Registry &registry()
+{
+    static Registry r;
+    return r;
+}
+
+// thread 結束後 buffer 仍由 registry 保有，事件可以照常寫出
+ThreadBuffer &localBuffer()
+{
+    thread_local ThreadBuffer *buffer = nullptr;
+    if (!buffer) {
+        auto created = std::make_shared<ThreadBuffer>();
+        created->written.store(0, std::memory_order_relaxed);
+
+        QThread *thread = QThread::currentThread();
+        const bool isMain = QCoreApplication::instance() &&
+                            thread == QCoreApplication::instance()->thread();
+        created->threadName = isMain ? QStringLiteral("GUI") : thread->objectName();
+
+        Registry &r = registry();
+        QMutexLocker lock(&r.mutex);
+        created->tid = r.buffers.size() + 1;
+        if (created->threadName.isEmpty()) {
+            created->threadName = QString("thread %1").arg(created->tid);
+        }
+        r.buffers.append(created);
+        buffer = created.get();
+    }
+    return *buffer;
+}
+
+void append(const char *name, qint64 ts, qint64 dur, char phase)
+{
+    ThreadBuffer &b = localBuffer();
+    const quint64 n = b.written.load(std::memory_order_relaxed);
+    Event &e = b.events[n % Trace::BUFFER_EVENTS];
+    e.name = name;
+    e.ts = ts;
+    e.dur = dur;
+    e.phase = phase;
+    b.written.store(n + 1, std::memory_order_release);
+}
+
+QString jsonString(QString s)
+{
+    s.replace('\\', "\\\\");
+    s.replace('"', "\\\"");
+    return s;
+}
+
+} // namespace
+
+namespace Trace
+{
+
+qint64 now()
+{
+    return registry().clock.nsecsElapsed();
+}
+
+void complete(const char *name, qint64 startNs, qint64 endNs)
+{
+    append(name, startNs, endNs - startNs, 'X');
+}
+
+void asyncBegin(const char *name, quint64 id)
+{
+    append(name, now(), qint64(id), 'b');
+}
+
+void asyncEnd(const char *name, quint64 id)
+{
+    append(name, now(), qint64(id), 'e');
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// write(): 逐個 buffer 複製一份再輸出
+//    複製前後各讀一次 written；複製期間可能被覆蓋的最舊幾筆直接捨棄
+////////////////////////////////////////////////////////////////////////////////
+bool write(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        return false;
+    }
+
+    QVector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        Registry &r = registry();
+        QMutexLocker lock(&r.mutex);
+        buffers = r.buffers;
+    }
+
+    QTextStream out(&file);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&]() -> QTextStream & {
+        if (!first) out << ",\n";
+        first = false;
+        return out;
+    };
+
+    std::unique_ptr<Event[]> copy(new Event[BUFFER_EVENTS]);
+    for (const auto &b : buffers) {
+        separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << b->tid
+                    << ",\"args\":{\"name\":\"" << jsonString(b->threadName) << "\"}}";
+
+        const quint64 before = b->written.load(std::memory_order_acquire);
+        const quint64 begin = before > quint64(BUFFER_EVENTS) ? before - BUFFER_EVENTS : 0;
+        for (quint64 n = begin; n < before; ++n) {
+            copy[n - begin] = b->events[n % BUFFER_EVENTS];
+        }
+        // 寫入中的那一筆 (第 after 筆) 可能已蓋掉第 after + 1 - BUFFER_EVENTS 筆
+        const quint64 after = b->written.load(std::memory_order_acquire);
+        const quint64 valid = after + 1 > quint64(BUFFER_EVENTS) ? after + 1 - BUFFER_EVENTS : 0;
+
+        for (quint64 n = qMax(begin, valid); n < before; ++n) {
+            const Event &e = copy[n - begin];
+            separator() << "{\"name\":\"" << jsonString(QString::fromLatin1(e.name)) << "\",\"ph\":\"" << e.phase
+                        << "\",\"pid\":1,\"tid\":" << b->tid
+                        << ",\"ts\":" << QString::number(e.ts / 1000.0, 'f', 3);
+            if (e.phase == 'X') {
+                out << ",\"dur\":" << QString::number(e.dur / 1000.0, 'f', 3);
+            } else {
+                out << ",\"cat\":\"async\",\"id\":" << quint64(e.dur);
+            }
+            out << '}';
+        }
+    }
+    out << "\n]}\n";
+    out.flush();
+    return file.error() == QFileDevice::NoError;
+}
+
+QString writeDefault()
+{
+    const QString dirPath = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)
+                            + "/trace";
+    const QString fileName = QString("%1/trace-%2.json")
+                                 .arg(dirPath)
+                                 .arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss"));
+    if (!QDir().mkpath(dirPath) || !write(fileName)) {
+        return QString();
+    }
+    return fileName;
+}
+
+} // namespace Trace
@@ -0,0 +1,63 @@
+// Trace.h
+#pragma once
+
+#include <QString>
+#include <QtGlobal>
+
+/*
+ * Trace
+ *  - 以 scope 標記整個回合流程，輸出成 Chrome trace-event JSON
+ *    (chrome://tracing 或 https://ui.perfetto.dev 直接開啟)
+ *  - 只有以 qmake CONFIG+=trace 建置 (定義 TOS_TRACE) 時才會編入；
+ *    否則下面的 TOS_TRACE_* 巨集全部展開成空的，程式碼裡沒有任何殘留
+ *  - 每個 thread 第一次記錄時配置自己的固定大小 ring buffer，之後寫入只動自己的 buffer，
+ *    不上鎖；buffer 滿了就覆蓋最舊的事件
+ *  - write() 可在任何時候從任何 thread 呼叫 (程式結束時、或 UI 按鍵)，讀取時不擋記錄的 thread
+ *
+ *  名稱一律使用字串常值 (只存指標)。
+ */
+namespace Trace
+{
+    // 目前 thread 的 buffer 容量 (事件數)
+    static constexpr int BUFFER_EVENTS = 1 << 15;
+
+    // 時間原點之後的奈秒數 (所有 thread 共用同一個原點)
+    qint64 now();
+
+    // 'X'：一段完整的區間
+    void complete(const char *name, qint64 startNs, qint64 endNs);
+
+    // 'b' / 'e'：跨呼叫 (或跨 thread) 的非同步區間，以 name + id 配對
+    void asyncBegin(const char *name, quint64 id);
+    void asyncEnd(const char *name, quint64 id);
+
+    // 目前所有 thread 的事件寫成 JSON；回傳是否成功
+    bool write(const QString &path);
+
+    // 寫到 <AppLocalData>/trace/trace-<時間>.json；回傳檔名 (失敗時為空字串)
+    QString writeDefault();
+
+    class Scope
+    {
+    public:
+        explicit Scope(const char *name) : name(name), start(now()) {}
+        ~Scope() { complete(name, start, now()); }
+
+    private:
+        Q_DISABLE_COPY(Scope)
+        const char *name;
+        qint64      start;
+    };
+}
+
+#ifdef TOS_TRACE
+#  define TOS_TRACE_CONCAT2(a, b) a##b
+#  define TOS_TRACE_CONCAT(a, b)  TOS_TRACE_CONCAT2(a, b)
+#  define TOS_TRACE_SCOPE(name)            Trace::Scope TOS_TRACE_CONCAT(tosTraceScope, __LINE__)(name)
+#  define TOS_TRACE_ASYNC_BEGIN(name, id)  Trace::asyncBegin(name, id)
+#  define TOS_TRACE_ASYNC_END(name, id)    Trace::asyncEnd(name, id)
+#else
+#  define TOS_TRACE_SCOPE(name)
+#  define TOS_TRACE_ASYNC_BEGIN(name, id)
+#  define TOS_TRACE_ASYNC_END(name, id)
+#endif
@@ -0,0 +1,15 @@
+# 連結 TOSCore 靜態函式庫 (由 core/core.pro 產生)
+# 使用方式：在其他 .pro 裡 include(<相對路徑>/core/core.pri)
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+# qmake CONFIG+=trace：連結的程式也要一起編入 Trace 標記
+trace: DEFINES += TOS_TRACE
+
+TOS_CORE_OUT = $$shadowed($$PWD)
+
+LIBS += -L$$TOS_CORE_OUT -lTOSCore
+
+win32-msvc*: PRE_TARGETDEPS += $$TOS_CORE_OUT/TOSCore.lib
+else: PRE_TARGETDEPS += $$TOS_CORE_OUT/libTOSCore.a
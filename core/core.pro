@@ -0,0 +1,48 @@
+TEMPLATE = lib
+TARGET = TOSCore
+
+CONFIG += staticlib c++11
+QT = core
+
+# 輸出固定放在 build 目錄下的 core/，不分 debug/release 子目錄，方便 core.pri 連結
+DESTDIR = $$OUT_PWD
+
+# qmake CONFIG+=trace：編入 Trace 標記 (見 Trace.h)
+trace: DEFINES += TOS_TRACE
+
+SOURCES += \
+    Character.cpp \
+    Combatants.cpp \
+    Damage.cpp \
+    DragSolver.cpp \
+    Enemy.cpp \
+    GameEngine.cpp \
+    Gem.cpp \
+    GemBoard.cpp \
+    InputLog.cpp \
+    MatchTracker.cpp \
+    MissionTable.cpp \
+    Replay.cpp \
+    ReplayFile.cpp \
+    Trace.cpp
+
+HEADERS += \
+    BitBoard.h \
+    Character.h \
+    Combatants.h \
+    Damage.h \
+    DragSolver.h \
+    Enemy.h \
+    GameEngine.h \
+    Gem.h \
+    GemBoard.h \
+    InputLog.h \
+    MatchTracker.h \
+    MissionTable.h \
+    Replay.h \
+    ReplayFile.h \
+    Trace.h
+
+# 內建的 mission 定義檔 (MissionTable::shared() 會註冊這份資源)
+RESOURCES += \
+    missions.qrc
@@ -0,0 +1,408 @@
+// BoardBenchmark.cpp
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QVector>
+#include <QtEndian>
+#include <QtTest>
+#include "Combatants.h"
+#include "Damage.h"
+#include "DragSolver.h"
+#include "GameEngine.h"
+#include "GameController.h"
+#include "GameStageWidget.h"
+#include "MatchTracker.h"
+#include "MissionTable.h"
+
+/*
+ * TOSBench
+ *  盤面與繪製熱點的 microbenchmark (QtTest QBENCHMARK)。
+ *  所有盤面都來自固定種子的 corpus，每次執行結果可互相比較。
+ *
+ *  機器可讀輸出：
+ *    TOSBench -o results.xml,xml      (QtTest XML，含每個 benchmark 的數值)
+ *    TOSBench -o results.csv,csv      (CSV)
+ *  預設使用 offscreen platform，可在無顯示器的機器上量 widget 路徑。
+ */
+class BoardBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    // 規則核心
+    void findAllMatches();
+    void incrementalMatches();
+    void generateInitialGems();
+    void clearMatchedGems();
+    void applyGravityAndRefill();
+    void getBoardMatrix();
+    void dragSolver();
+    void enemyTurn();
+    void teamDamage();
+    void loadMissionTable();
+
+    // 畫面
+    void showBoard();
+    void clearBoard();
+    void waveTransition();
+
+private:
+    static constexpr int CORPUS_SIZE = 256;
+    static constexpr quint32 CORPUS_SEED = 20250601;
+
+    QVector<GemBoard>        corpus;        // 固定種子產生的盤面
+    QVector<BitBoard::Mask>  corpusMatches; // 每個盤面的 matched 格子
+    QVector<Character*>      party;
+};
+
+void BoardBenchmark::initTestCase()
+{
+    QRandomGenerator rng(CORPUS_SEED);
+    corpus.resize(CORPUS_SIZE);
+    corpusMatches.resize(CORPUS_SIZE);
+
+    BitBoard::MatchResult match;
+    for (int i = 0; i < CORPUS_SIZE; ++i) {
+        GemBoard &b = corpus[i];
+        for (int cell = 0; cell < GemBoard::CELLS; ++cell) {
+            b.cell(cell) = Gem::make(static_cast<Gem::Attribute>(rng.bounded(BitBoard::ATTR_COUNT)));
+        }
+        BitBoard::findMatches(b.planes(), match);
+        corpusMatches[i] = match.matched;
+    }
+
+    party = Character::createParty(QVector<int>{ 1, 2, 3, 4, 5, 0 }, 2000);
+}
+
+void BoardBenchmark::cleanupTestCase()
+{
+    qDeleteAll(party);
+    party.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 規則核心
+////////////////////////////////////////////////////////////////////////////////
+
+void BoardBenchmark::findAllMatches()
+{
+    BitBoard::MatchResult match;
+    int combos = 0;
+    QBENCHMARK {
+        for (const GemBoard &b : corpus) {
+            BitBoard::findMatches(b.planes(), match);
+            combos += match.comboCount;
+        }
+    }
+    QVERIFY(combos >= 0);
+}
+
+// 轉珠中的一步：交換相鄰兩格後只更新受影響的列與欄，再切 combo
+void BoardBenchmark::incrementalMatches()
+{
+    MatchTracker tracker;
+
+    // 先確認增量結果與整盤重算一致：每個盤面隨機走 SWAPS 步相鄰交換
+    {
+        static constexpr int SWAPS = 64;
+        QRandomGenerator rng(CORPUS_SEED);
+        BitBoard::MatchResult full;
+        for (const GemBoard &b : corpus) {
+            GemBoard copy = b;
+            tracker.reset(b);
+            for (int i = 0; i < SWAPS; ++i) {
+                const bool vertical = rng.bounded(2) == 1;
+                const int r = rng.bounded(vertical ? GemBoard::ROWS - 1 : GemBoard::ROWS);
+                const int c = rng.bounded(vertical ? GemBoard::COLS : GemBoard::COLS - 1);
+                const int r2 = vertical ? r + 1 : r;
+                const int c2 = vertical ? c : c + 1;
+
+                tracker.swap(r, c, r2, c2);
+                copy.swap(r, c, r2, c2);
+                BitBoard::findMatches(copy.planes(), full);
+
+                const MatchTracker::Preview preview = tracker.preview();
+                QCOMPARE(preview.matched, full.matched);
+                QCOMPARE(preview.comboCount, full.comboCount);
+            }
+        }
+    }
+
+    int combos = 0;
+    QBENCHMARK {
+        for (const GemBoard &b : corpus) {
+            tracker.reset(b);
+            for (int cell = 0; cell + 1 < GemBoard::CELLS; ++cell) {
+                if (BitBoard::colOf(cell) == GemBoard::COLS - 1) continue;
+                const int r = BitBoard::rowOf(cell);
+                const int c = BitBoard::colOf(cell);
+                tracker.swap(r, c, r, c + 1);
+                combos += tracker.preview().comboCount;
+            }
+        }
+    }
+    QVERIFY(combos >= 0);
+}
+
+void BoardBenchmark::generateInitialGems()
+{
+    GameEngine engine;
+    engine.setSeed(CORPUS_SEED);
+    QBENCHMARK {
+        for (int i = 0; i < CORPUS_SIZE; ++i) {
+            engine.generateInitialGems();
+        }
+    }
+}
+
+void BoardBenchmark::clearMatchedGems()
+{
+    GameEngine engine;
+    QBENCHMARK {
+        for (int i = 0; i < CORPUS_SIZE; ++i) {
+            engine.loadBoard(corpus[i]);
+            engine.clearCells(corpusMatches[i]);
+        }
+    }
+}
+
+void BoardBenchmark::applyGravityAndRefill()
+{
+    GameEngine engine;
+    engine.setSeed(CORPUS_SEED);
+    QBENCHMARK {
+        for (int i = 0; i < CORPUS_SIZE; ++i) {
+            engine.loadBoard(corpus[i]);
+            engine.clearCells(corpusMatches[i]);
+            engine.applyGravityAndRefill();
+        }
+    }
+}
+
+void BoardBenchmark::getBoardMatrix()
+{
+    GameController controller;
+    controller.init(party, 1);
+    controller.startMission();
+
+    int occupied = 0;
+    QBENCHMARK {
+        for (int i = 0; i < CORPUS_SIZE; ++i) {
+            GemBoard copy = controller.getBoardMatrix();
+            occupied += copy.isEmpty(0, 0) ? 0 : 1;
+        }
+    }
+    QVERIFY(occupied > 0);
+}
+
+void BoardBenchmark::dragSolver()
+{
+    // 預設設定 (全部核心)；每次解 corpus 的下一個盤面
+    const DragSolver solver;
+    int i = 0;
+    int combos = 0;
+    QBENCHMARK {
+        combos += solver.solve(corpus[i]).comboCount;
+        i = (i + 1) % CORPUS_SIZE;
+    }
+    QVERIFY(combos > 0);
+}
+
+void BoardBenchmark::enemyTurn()
+{
+    // 一波 600 隻敵人打 6 人隊伍：全波攻擊力加總 → 打在第一個活著的角色 → 整波復活
+    Combatants enemies;
+    Combatants players;
+    QRandomGenerator rng(CORPUS_SEED);
+    enemies.reserve(600);
+    for (int i = 0; i < 600; ++i) {
+        enemies.add(40 + rng.bounded(60), 1 + rng.bounded(3), rng.bounded(5), 2 + rng.bounded(3));
+    }
+    for (int i = 0; i < 6; ++i) {
+        players.add(1 << 30, 0, i % 5, 0);
+    }
+    enemies.kill(0, 200);
+
+    int absorbed = 0;
+    QBENCHMARK {
+        absorbed += players.takeHits(0, players.size(), enemies, 0, enemies.size());
+        players.revive(0, players.size());
+        enemies.revive(400, enemies.size());
+    }
+    QVERIFY(absorbed > 0);
+}
+
+void BoardBenchmark::teamDamage()
+{
+    // corpus 各盤面第一輪的消除 → 全隊傷害 (屬性相剋 + combo 倍率)
+    const Combatants &units = *party.first()->units();
+    BitBoard::MatchResult match;
+    int i = 0;
+    int total = 0;
+    QBENCHMARK {
+        BitBoard::findMatches(corpus[i].planes(), match);
+        Damage::Input in;
+        for (int a = 0; a < BitBoard::ATTR_COUNT; ++a) {
+            in.clearedCount[a] = BitBoard::count(match.attrMatched[a]);
+        }
+        in.comboCount = match.comboCount;
+        in.defender = i % BitBoard::ATTR_COUNT;
+
+        Damage::Result out;
+        Damage::teamDamage(units, 0, units.size(), in, out);
+        total += out.total;
+        i = (i + 1) % CORPUS_SIZE;
+    }
+    QVERIFY(total > 0);
+}
+
+void BoardBenchmark::loadMissionTable()
+{
+    const QByteArray bytes = MissionTable::shared().toBinary();
+    const uchar *data = reinterpret_cast<const uchar *>(bytes.constData());
+    MissionTable table;
+
+    // 先確認 toBinary() → loadBinary() 原樣還原，且 loadJson() 會擋下的欄位改壞之後
+    // loadBinary() 也拒絕 (偏移量依 MissionTable.h 的 .tosm 格式)
+    {
+        QVERIFY(table.loadBinary(data, bytes.size()));
+        QCOMPARE(table.toBinary(), bytes);
+        QVERIFY(qFromLittleEndian<quint16>(data + 14) >= 2);
+
+        const int missionAt = 24;
+        const int waveAt = missionAt + qFromLittleEndian<quint16>(data + 8) * 18;
+        const int enemyAt = waveAt + qFromLittleEndian<quint16>(data + 10) * 4
+                                   + qFromLittleEndian<quint16>(data + 12) * 2;
+        const quint16 dropTotal = qFromLittleEndian<quint16>(data + missionAt + 6);
+        const quint16 firstEnemyID = qFromLittleEndian<quint16>(data + enemyAt + 4);
+
+        struct Corruption
+        {
+            const char *field;
+            int         offset;
+            int         size;
+            quint32     value;
+        };
+        const Corruption corruptions[] = {
+            { "mission id = 0",      missionAt,         2, 0 },
+            { "waveCount = 0",       missionAt + 4,     2, 0 },
+            { "dropTotal != sum",    missionAt + 6,     2, quint32(dropTotal + 1) },
+            { "enemyCount = 0",      waveAt + 2,        2, 0 },
+            { "maxHP = 0",           enemyAt,           4, 0 },
+            { "enemy id = 0",        enemyAt + 4,       2, 0 },
+            { "cooldown = 0",        enemyAt + 9,       1, 0 },
+            { "duplicate enemy id",  enemyAt + 12 + 4,  2, firstEnemyID },
+        };
+        for (const Corruption &c : corruptions) {
+            QByteArray bad = bytes;
+            uchar *p = reinterpret_cast<uchar *>(bad.data()) + c.offset;
+            if (c.size == 4)      qToLittleEndian<quint32>(c.value, p);
+            else if (c.size == 2) qToLittleEndian<quint16>(quint16(c.value), p);
+            else                  *p = uchar(c.value);
+            QVERIFY2(!table.loadBinary(reinterpret_cast<const uchar *>(bad.constData()), bad.size()),
+                     c.field);
+        }
+    }
+
+    int missions = 0;
+    QBENCHMARK {
+        table.loadBinary(data, bytes.size());
+        missions += table.missionCount();
+    }
+    QVERIFY(missions > 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 畫面 (offscreen platform)
+////////////////////////////////////////////////////////////////////////////////
+
+void BoardBenchmark::showBoard()
+{
+    GameStageWidget stage;
+    stage.resize(540, 960);
+    stage.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&stage));
+
+    // 每次換成 corpus 的下一個盤面，並讓 paint 真正跑完
+    int i = 0;
+    QBENCHMARK {
+        stage.showBoard(corpus[i]);
+        QCoreApplication::processEvents();
+        i = (i + 1) % CORPUS_SIZE;
+    }
+}
+
+void BoardBenchmark::clearBoard()
+{
+    GameStageWidget stage;
+    stage.resize(540, 960);
+    stage.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&stage));
+
+    int i = 0;
+    QBENCHMARK {
+        stage.showBoard(corpus[i]);
+        stage.clearBoard();
+        QCoreApplication::processEvents();
+        i = (i + 1) % CORPUS_SIZE;
+    }
+}
+
+// 換波：下一波的敵人列已在背景排好，量 showEnemies() + showBoard() 切換到畫完為止
+//    (三波輪流，每次背景都要重排；背景排列不計時，每次切換量一次，回報平均)
+void BoardBenchmark::waveTransition()
+{
+    static constexpr int WAVE_ENEMIES = 64;
+    static constexpr int SWITCHES = 64;
+
+    GameStageWidget stage;
+    stage.resize(540, 960);
+    stage.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&stage));
+
+    const char *icons[3] = { ":/enemy/dataset/enemy/96n.png",
+                             ":/enemy/dataset/enemy/98n.png",
+                             ":/enemy/dataset/enemy/100n.png" };
+    QVector<Enemy*> waves[3];
+    for (int w = 0; w < 3; ++w) {
+        for (int i = 0; i < WAVE_ENEMIES; ++i) {
+            waves[w].append(new Enemy(100 + i, Character::Water, 100, icons[w], 3));
+        }
+    }
+
+    QElapsedTimer timer;
+    qint64 total = 0;
+    for (int i = 0; i < SWITCHES; ++i) {
+        const QVector<Enemy*> &next = waves[i % 3];
+        stage.prefetchEnemies(next);
+        while (stage.isPrefetching()) {
+            QCoreApplication::processEvents();
+        }
+
+        timer.start();
+        stage.showEnemies(next);
+        stage.showBoard(corpus[i % CORPUS_SIZE]);
+        QCoreApplication::processEvents();
+        total += timer.nsecsElapsed();
+    }
+    QTest::setBenchmarkResult(qreal(total) / SWITCHES, QTest::WalltimeNanoseconds);
+
+    for (QVector<Enemy*> &wave : waves) {
+        qDeleteAll(wave);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    BoardBenchmark bench;
+    return QTest::qExec(&bench, argc, argv);
+}
+
+#include "BoardBenchmark.moc"
@@ -0,0 +1,44 @@
+QT += core gui widgets concurrent testlib
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+TARGET = TOSBench
+
+include(../../core/core.pri)
+
+# 直接編譯 app 裡受測的 controller / widget
+APP_DIR = ../../app
+INCLUDEPATH += $$APP_DIR
+
+SOURCES += \
+    BoardBenchmark.cpp \
+    $$APP_DIR/AssetPreloader.cpp \
+    $$APP_DIR/BoardWidget.cpp \
+    $$APP_DIR/FrameClock.cpp \
+    $$APP_DIR/GameController.cpp \
+    $$APP_DIR/GameEventChannel.cpp \
+    $$APP_DIR/GameStageWidget.cpp \
+    $$APP_DIR/GemSprite.cpp \
+    $$APP_DIR/HintEngine.cpp \
+    $$APP_DIR/PerfOverlay.cpp \
+    $$APP_DIR/PerfStats.cpp \
+    $$APP_DIR/SpriteCache.cpp \
+    $$APP_DIR/StallWatchdog.cpp
+
+HEADERS += \
+    $$APP_DIR/AssetPreloader.h \
+    $$APP_DIR/BoardWidget.h \
+    $$APP_DIR/FrameClock.h \
+    $$APP_DIR/GameController.h \
+    $$APP_DIR/GameEventChannel.h \
+    $$APP_DIR/GameStageWidget.h \
+    $$APP_DIR/GemSprite.h \
+    $$APP_DIR/HintEngine.h \
+    $$APP_DIR/PerfOverlay.h \
+    $$APP_DIR/PerfStats.h \
+    $$APP_DIR/SpriteCache.h \
+    $$APP_DIR/StallWatchdog.h
+
+RESOURCES += \
+    ../../data.qrc
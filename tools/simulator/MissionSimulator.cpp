@@ -0,0 +1,128 @@
+// MissionSimulator.cpp
+#include "MissionSimulator.h"
+#include "DragSolver.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Stats
+////////////////////////////////////////////////////////////////////////////////
+
+void MissionSimulator::Stats::add(const GameResult &r)
+{
+    ++games;
+    if (r.won) {
+        ++wins;
+        turnsToClear += r.turns;
+    }
+    if (r.timedOut) ++timeouts;
+    turns += r.turns;
+    combos += r.combos;
+    hpRemaining += r.hpRemaining;
+}
+
+void MissionSimulator::Stats::merge(const Stats &other)
+{
+    games += other.games;
+    wins += other.wins;
+    timeouts += other.timeouts;
+    turns += other.turns;
+    turnsToClear += other.turnsToClear;
+    combos += other.combos;
+    hpRemaining += other.hpRemaining;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// bestSwap(): 試遍 49 個相鄰交換 (橫 25 + 直 24)，挑 combo 最多的一個
+////////////////////////////////////////////////////////////////////////////////
+
+bool MissionSimulator::bestSwap(const GemBoard &board, int &r1, int &c1, int &r2, int &c2)
+{
+    GemBoard trial = board;
+    BitBoard::MatchResult match;
+    int bestCombos = 0;
+    int bestCells = 0;
+
+    auto tryOne = [&](int ar, int ac, int br, int bc) {
+        trial.swap(ar, ac, br, bc);
+        BitBoard::findMatches(trial.planes(), match);
+        trial.swap(ar, ac, br, bc);
+
+        const int cells = BitBoard::count(match.matched);
+        if (match.comboCount > bestCombos ||
+            (match.comboCount == bestCombos && cells > bestCells))
+        {
+            bestCombos = match.comboCount;
+            bestCells = cells;
+            r1 = ar; c1 = ac; r2 = br; c2 = bc;
+        }
+    };
+
+    for (int r = 0; r < GemBoard::ROWS; ++r) {
+        for (int c = 0; c < GemBoard::COLS; ++c) {
+            if (c + 1 < GemBoard::COLS) tryOne(r, c, r, c + 1);
+            if (r + 1 < GemBoard::ROWS) tryOne(r, c, r + 1, c);
+        }
+    }
+    return bestCombos > 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// playGame(): 完整打完一局
+////////////////////////////////////////////////////////////////////////////////
+
+MissionSimulator::GameResult MissionSimulator::playGame(const Config &config, quint32 seed)
+{
+    GameResult result = GameResult();
+
+    QVector<Character*> party = Character::createParty(config.team, config.totalHP);
+
+    // 模擬本身已經按局平行，solver 只用呼叫端的 thread
+    DragSolver::Config solverConfig;
+    solverConfig.threads = 1;
+    solverConfig.beamWidth = config.solverBeam;
+    solverConfig.maxSteps = config.solverSteps;
+    solverConfig.timeBudgetMs = 10 * 1000;
+    const DragSolver solver(solverConfig);
+
+    GameEngine engine;
+    engine.setSeed(seed);
+    engine.init(party, config.missionID);
+    engine.startMission();
+
+    while (engine.phase() != GameEngine::Won && engine.phase() != GameEngine::Lost) {
+        if (engine.phase() == GameEngine::PlayerMove) {
+            if (result.turns >= config.maxTurns) {
+                result.timedOut = true;
+                break;
+            }
+            if (config.player == GreedyPlayer) {
+                int r1 = 0, c1 = 0, r2 = 0, c2 = 0;
+                if (bestSwap(engine.board(), r1, c1, r2, c2)) {
+                    engine.swapGems(r1, c1, r2, c2);
+                }
+            } else if (config.player == SolverPlayer) {
+                const Combatants &units = engine.partyCombatants();
+                const DragSolver::Attackers attackers(units, 0, units.size(), engine.currentDefender());
+                const DragSolver::Result best = solver.solve(engine.board(), attackers);
+                for (int i = 0; i < best.path.length; ++i) {
+                    int r1 = 0, c1 = 0, r2 = 0, c2 = 0;
+                    DragSolver::stepCells(best.path, i, r1, c1, r2, c2);
+                    engine.swapGems(r1, c1, r2, c2);
+                }
+            }
+            engine.endMove();
+            ++result.turns;
+        }
+
+        const GameEngine::StepResult r = engine.step();
+        if (r.event == GameEngine::DamageDealt) {
+            result.combos += r.comboCount;
+        }
+    }
+
+    result.won = (engine.phase() == GameEngine::Won);
+    for (Character *c : party) {
+        result.hpRemaining += c->getCurrentHP();
+        delete c;
+    }
+    return result;
+}
@@ -0,0 +1,59 @@
+// MissionSimulator.h
+#pragma once
+
+#include <QVector>
+#include <QString>
+#include "GameEngine.h"
+
+/*
+ * MissionSimulator
+ *  - 以 GameEngine 的真實規則，無 event loop 地完整打完一局 mission
+ *  - 玩家由腳本控制：Idle (不轉珠)、Greedy (每回合挑 combo 最多的相鄰交換)
+ *    或 Solver (以 DragSolver 搜尋拖動路徑，同 combo 時挑對本波目標傷害最高的)
+ *  - 每局使用固定種子，同樣的參數一定得到同樣的結果
+ */
+class MissionSimulator
+{
+public:
+    enum Player { IdlePlayer = 0, GreedyPlayer, SolverPlayer };
+
+    struct Config
+    {
+        int          missionID;
+        QVector<int> team;          // 6 格角色 ID (0 表示空格)
+        int          totalHP;
+        Player       player;
+        int          maxTurns;      // 超過視為平手 (避免無限回合)
+        int          solverBeam;    // SolverPlayer 的 beam 寬度
+        int          solverSteps;   // SolverPlayer 最多拖幾步
+    };
+
+    struct GameResult
+    {
+        bool won;
+        bool timedOut;
+        int  turns;                 // 玩家回合數
+        int  combos;                // 全部回合的 combo 總數
+        int  hpRemaining;           // 結束時隊伍剩餘 HP
+    };
+
+    // 累積多局的統計 (每個 worker 一份，最後再合併)
+    struct Stats
+    {
+        qint64 games;
+        qint64 wins;
+        qint64 timeouts;
+        qint64 turns;
+        qint64 turnsToClear;        // 只計勝場
+        qint64 combos;
+        qint64 hpRemaining;
+
+        void add(const GameResult &r);
+        void merge(const Stats &other);
+    };
+
+    static GameResult playGame(const Config &config, quint32 seed);
+
+    // 從目前盤面挑出 combo 數最多的相鄰交換；沒有能消除的交換則回傳 false
+    static bool bestSwap(const GemBoard &board, int &r1, int &c1, int &r2, int &c2);
+};
@@ -0,0 +1,75 @@
+// WorkStealingPool.cpp
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <thread>
+
+WorkStealingPool::WorkStealingPool(int threadCount)
+    : threads(std::max(1, threadCount))
+{
+    for (int i = 0; i < threads; ++i) {
+        queues.emplace_back(new Queue);
+    }
+}
+
+int WorkStealingPool::threadCount() const
+{
+    return threads;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// run(): 分配工作、啟動 worker、等全部結束
+////////////////////////////////////////////////////////////////////////////////
+void WorkStealingPool::run(int jobCount, const Job &job)
+{
+    for (int i = 0; i < jobCount; ++i) {
+        queues[i % threads]->jobs.push_back(i);
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (int w = 1; w < threads; ++w) {
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, w, std::cref(job));
+    }
+
+    // 呼叫端的 thread 也當作 worker 0
+    workerLoop(0, job);
+
+    for (std::thread &t : workers) {
+        t.join();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// popLocal() / steal(): 自己的從尾端拿，偷別人的從前端拿
+////////////////////////////////////////////////////////////////////////////////
+bool WorkStealingPool::popLocal(int worker, int &jobIndex)
+{
+    Queue &q = *queues[worker];
+    std::lock_guard<std::mutex> guard(q.lock);
+    if (q.jobs.empty()) return false;
+    jobIndex = q.jobs.back();
+    q.jobs.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(int thief, int &jobIndex)
+{
+    for (int i = 1; i < threads; ++i) {
+        Queue &q = *queues[(thief + i) % threads];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (q.jobs.empty()) continue;
+        jobIndex = q.jobs.front();
+        q.jobs.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(int worker, const Job &job)
+{
+    int jobIndex = 0;
+    // 工作不會在執行中新增，所以所有佇列都空了就可以結束
+    while (popLocal(worker, jobIndex) || steal(worker, jobIndex)) {
+        job(jobIndex, worker);
+    }
+}
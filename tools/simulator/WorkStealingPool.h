@@ -0,0 +1,42 @@
+// WorkStealingPool.h
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*
+ * WorkStealingPool
+ *  - 每個 worker 有自己的工作佇列，工作一開始平均分配 (round-robin)
+ *  - worker 從自己的佇列尾端拿工作；自己空了就從其他 worker 的佇列前端偷
+ *  - 一局遊戲長短差很多 (幾回合就輸 ～ 打到最後一波)，偷工作可以避免某些核心提早閒置
+ */
+class WorkStealingPool
+{
+public:
+    // job(jobIndex, workerIndex)
+    typedef std::function<void(int, int)> Job;
+
+    explicit WorkStealingPool(int threadCount);
+
+    int threadCount() const;
+
+    // 執行 jobCount 個工作，全部完成後才返回
+    void run(int jobCount, const Job &job);
+
+private:
+    struct Queue
+    {
+        std::mutex      lock;
+        std::deque<int> jobs;
+    };
+
+    bool popLocal(int worker, int &jobIndex);
+    bool steal(int thief, int &jobIndex);
+    void workerLoop(int worker, const Job &job);
+
+    int                                 threads;
+    std::vector<std::unique_ptr<Queue>> queues;
+};
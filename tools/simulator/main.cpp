@@ -0,0 +1,263 @@
+// main.cpp (TOSSimulator)
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QStringList>
+#include <QTextStream>
+#include <QThread>
+#include <QtAlgorithms>
+#include <vector>
+#include "MissionSimulator.h"
+#include "MissionTable.h"
+#include "Replay.h"
+#include "ReplayFile.h"
+#include "WorkStealingPool.h"
+
+/*
+ * TOSSimulator
+ *  以 GameEngine 規則平行模擬大量 mission，統計每組隊伍的勝率、破關回合數、
+ *  剩餘 HP 與每回合 combo 數。第 i 局的種子固定為 seed + i，結果可重現。
+ *
+ *  例：TOSSimulator --mission 1 --games 20000 --player greedy --team 1,2,3 --team 4,4,5
+ *      TOSSimulator --mission 1 --games 500 --player solver --beam 200 --drag-steps 24
+ *      TOSSimulator --replay mission1_20250601-120000_1a2b3c4d.tosreplay   (重播並比對結果)
+ *      TOSSimulator --replay <file> --seek 40                              (跳到第 40 回合)
+ *      TOSSimulator --scan replays/                                        (整個資料夾做統計)
+ *      TOSSimulator --missions my_missions.json --mission 3                 (改用其他定義檔)
+ *      TOSSimulator --compile-missions missions.tosm                       (把定義檔預先編成二進位)
+ *      TOSSimulator --missions missions_stress.json --games 2000           (每波數百隻敵人的壓力測試)
+ */
+
+namespace {
+
+QVector<int> parseTeam(const QString &text)
+{
+    QVector<int> team(6, 0);
+    const QStringList ids = text.split(',', QString::SkipEmptyParts);
+    for (int i = 0; i < ids.size() && i < team.size(); ++i) {
+        team[i] = ids[i].trimmed().toInt();
+    }
+    return team;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// replayFiles(): 逐一 mmap 重播檔並全速重播，全部一致才回傳 0
+//    seekTurn >= 0 時改為從最近的 keyframe 跳到該回合，印出當時的狀態
+////////////////////////////////////////////////////////////////////////////////
+int replayFiles(const QStringList &paths, int seekTurn, QTextStream &out)
+{
+    int failures = 0;
+    for (const QString &path : paths) {
+        const bool readable = ReplayArchive::mapFile(path, [&](const QString &, const ReplayReader &reader) {
+            const ReplayReader::Header &h = reader.header();
+            QElapsedTimer clock;
+            clock.start();
+
+            if (seekTurn >= 0) {
+                GameEngine engine;
+                QVector<Character*> party;
+                reader.startEngine(engine, party);
+                const bool ok = reader.seek(seekTurn, engine);
+                out << path << ": turn " << seekTurn << " wave " << engine.currentWave()
+                    << " checksum " << QString::number(InputLog::checksum(engine), 16)
+                    << ", " << clock.nsecsElapsed() / 1000 << " us -> "
+                    << (ok ? "ok" : "SEEK FAILED") << "\n";
+                if (!ok) ++failures;
+                qDeleteAll(party);
+                return true;
+            }
+
+            const Replay::Result r = Replay::run(reader.toInputLog());
+            out << path << ": seed " << QString::number(h.seed, 16)
+                << ", " << h.inputCount << " inputs, " << r.outcome.turns << " turns, "
+                << clock.nsecsElapsed() / 1000 << " us -> "
+                << (r.matches ? "match" : "MISMATCH") << "\n";
+            if (!r.matches) ++failures;
+            return true;
+        });
+
+        if (!readable) {
+            out << path << ": cannot read replay\n";
+            ++failures;
+        }
+    }
+    return failures ? 1 : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// scanDirectory(): mmap 整個資料夾的重播檔，只讀 header 與回合紀錄做統計
+////////////////////////////////////////////////////////////////////////////////
+int scanDirectory(const QString &directory, QTextStream &out)
+{
+    qint64 files = 0, wins = 0, turns = 0, inputs = 0, swaps = 0, bytes = 0;
+    QElapsedTimer clock;
+    clock.start();
+
+    ReplayArchive::scan(directory, [&](const QString &path, const ReplayReader &reader) {
+        const ReplayReader::Header &h = reader.header();
+        ++files;
+        if (h.finished && h.finalPhase == GameEngine::Won) ++wins;
+        turns += h.turnCount;
+        bytes += QFileInfo(path).size();
+
+        ReplayReader::Cursor cursor = reader.cursor();
+        InputLog::Input input;
+        while (cursor.next(input)) {
+            ++inputs;
+            if (input.type == InputLog::Swap) ++swaps;
+        }
+        return true;
+    });
+
+    const double seconds = qMax<qint64>(1, clock.elapsed()) / 1000.0;
+    out << files << " replays, " << wins << " won, " << turns << " turns, "
+        << inputs << " inputs (" << swaps << " swaps), "
+        << QString::number(turns ? double(bytes) / turns : 0.0, 'f', 1) << " bytes/turn, "
+        << QString::number(files / seconds, 'f', 0) << " replays/s\n";
+    return files ? 0 : 1;
+}
+
+QString teamLabel(const QVector<int> &team)
+{
+    QStringList ids;
+    for (int id : team) {
+        if (id > 0) ids << QString::number(id);
+    }
+    return ids.join(',');
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("TOSSimulator");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Monte Carlo mission simulator for TOS");
+    parser.addHelpOption();
+
+    QCommandLineOption missionOpt("mission", "Mission ID.", "id", "1");
+    QCommandLineOption gamesOpt("games", "Games per team.", "n", "1000");
+    QCommandLineOption seedOpt("seed", "Base seed; game i uses seed + i.", "seed", "1");
+    QCommandLineOption playerOpt("player", "Scripted player: idle, greedy or solver.", "name", "greedy");
+    QCommandLineOption teamOpt("team", "Comma separated character IDs (repeatable).", "ids");
+    QCommandLineOption threadsOpt("threads", "Worker threads (0 = all cores).", "n", "0");
+    QCommandLineOption maxTurnsOpt("max-turns", "Turn limit per game.", "n", "500");
+    QCommandLineOption hpOpt("hp", "Total party HP.", "hp", "2000");
+    QCommandLineOption beamOpt("beam", "Beam width of the solver player.", "n", "200");
+    QCommandLineOption dragStepsOpt("drag-steps", "Max drag path length of the solver player.", "n", "24");
+    QCommandLineOption replayOpt("replay", "Replay a .tosreplay file and verify its outcome (repeatable).", "file");
+    QCommandLineOption seekOpt("seek", "With --replay: jump to this turn via the keyframe index.", "turn");
+    QCommandLineOption scanOpt("scan", "Memory-map every .tosreplay in a directory and print totals.", "dir");
+    QCommandLineOption missionsOpt("missions", "Mission definitions (.json or pre-compiled .tosm).", "file");
+    QCommandLineOption compileOpt("compile-missions", "Write the mission table as a pre-compiled .tosm file.", "file");
+    parser.addOptions({ missionOpt, gamesOpt, seedOpt, playerOpt, teamOpt,
+                        threadsOpt, maxTurnsOpt, hpOpt, beamOpt, dragStepsOpt,
+                        replayOpt, seekOpt, scanOpt, missionsOpt, compileOpt });
+    parser.process(app);
+
+    QTextStream out(stdout);
+
+    // 定義表必須在任何 worker 開始 mission 之前換好
+    if (parser.isSet(missionsOpt)) {
+        MissionTable table;
+        if (!table.loadFile(parser.value(missionsOpt))) {
+            out << "cannot load mission definitions " << parser.value(missionsOpt) << "\n";
+            return 1;
+        }
+        MissionTable::setShared(table);
+    }
+    if (parser.isSet(compileOpt)) {
+        const MissionTable &table = MissionTable::shared();
+        QFile file(parser.value(compileOpt));
+        const QByteArray bytes = table.toBinary();
+        if (table.isEmpty() || !file.open(QIODevice::WriteOnly) || file.write(bytes) != bytes.size()) {
+            out << "cannot write " << parser.value(compileOpt) << "\n";
+            return 1;
+        }
+        out << table.missionCount() << " missions, " << bytes.size() << " bytes\n";
+        return 0;
+    }
+
+    if (parser.isSet(scanOpt)) {
+        return scanDirectory(parser.value(scanOpt), out);
+    }
+    if (parser.isSet(replayOpt)) {
+        const int seekTurn = parser.isSet(seekOpt) ? parser.value(seekOpt).toInt() : -1;
+        return replayFiles(parser.values(replayOpt), seekTurn, out);
+    }
+
+    QStringList teamArgs = parser.values(teamOpt);
+    if (teamArgs.isEmpty()) teamArgs << "1,2,3";
+
+    const int games = qMax(1, parser.value(gamesOpt).toInt());
+    const quint32 baseSeed = parser.value(seedOpt).toUInt();
+    int threads = parser.value(threadsOpt).toInt();
+    if (threads <= 0) threads = QThread::idealThreadCount();
+
+    MissionSimulator::Config config;
+    config.missionID = parser.value(missionOpt).toInt();
+    config.totalHP = parser.value(hpOpt).toInt();
+    config.maxTurns = parser.value(maxTurnsOpt).toInt();
+    config.solverBeam = parser.value(beamOpt).toInt();
+    config.solverSteps = parser.value(dragStepsOpt).toInt();
+
+    const QString playerName = parser.value(playerOpt);
+    if (playerName == "idle") {
+        config.player = MissionSimulator::IdlePlayer;
+    } else if (playerName == "solver") {
+        config.player = MissionSimulator::SolverPlayer;
+    } else {
+        config.player = MissionSimulator::GreedyPlayer;
+    }
+
+    WorkStealingPool pool(threads);
+
+    out << "mission " << config.missionID << ", " << games << " games/team, "
+        << pool.threadCount() << " threads, player " << parser.value(playerOpt) << "\n";
+    out << qSetFieldWidth(14) << left << "team"
+        << qSetFieldWidth(9) << right << "games" << "win%" << "timeout"
+        << qSetFieldWidth(12) << "turns/clear" << "hp left" << "combo/turn"
+        << qSetFieldWidth(0) << "\n";
+
+    qint64 totalTurns = 0;
+    QElapsedTimer clock;
+    clock.start();
+
+    for (const QString &teamArg : teamArgs) {
+        config.team = parseTeam(teamArg);
+
+        // 每個 worker 一份統計，避免共用鎖
+        std::vector<MissionSimulator::Stats> perWorker(pool.threadCount(),
+                                                       MissionSimulator::Stats());
+        pool.run(games, [&](int game, int worker) {
+            perWorker[worker].add(MissionSimulator::playGame(config, baseSeed + quint32(game)));
+        });
+
+        MissionSimulator::Stats total = MissionSimulator::Stats();
+        for (const MissionSimulator::Stats &s : perWorker) {
+            total.merge(s);
+        }
+        totalTurns += total.turns;
+
+        const double winRate = 100.0 * total.wins / total.games;
+        const double turnsToClear = total.wins ? double(total.turnsToClear) / total.wins : 0.0;
+        const double hpLeft = double(total.hpRemaining) / total.games;
+        const double combosPerTurn = total.turns ? double(total.combos) / total.turns : 0.0;
+
+        out << qSetFieldWidth(14) << left << teamLabel(config.team)
+            << qSetFieldWidth(9) << right << total.games
+            << QString::number(winRate, 'f', 1) << total.timeouts
+            << qSetFieldWidth(12) << QString::number(turnsToClear, 'f', 2)
+            << QString::number(hpLeft, 'f', 1) << QString::number(combosPerTurn, 'f', 3)
+            << qSetFieldWidth(0) << "\n";
+    }
+
+    const double seconds = qMax<qint64>(1, clock.elapsed()) / 1000.0;
+    out << totalTurns << " turns in " << QString::number(seconds, 'f', 2) << " s ("
+        << QString::number(totalTurns / seconds * 60.0, 'f', 0) << " turns/min)\n";
+    return 0;
+}
@@ -0,0 +1,20 @@
+QT = core
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+TARGET = TOSSimulator
+
+include(../../core/core.pri)
+
+SOURCES += \
+    MissionSimulator.cpp \
+    WorkStealingPool.cpp \
+    main.cpp
+
+HEADERS += \
+    MissionSimulator.h \
+    WorkStealingPool.h
+
+# std::thread
+unix: LIBS += -lpthread